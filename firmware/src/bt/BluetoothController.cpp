@@ -49,6 +49,7 @@ BluetoothController::BluetoothController(
     _pKeepAliveCharacteristic(nullptr),
     _pFirmwareVersionCharacteristic(nullptr),
     _pBatteryStatusCharacteristic(nullptr),
+    _pPerfStatsCharacteristic(nullptr),
     _pPresetSaveCharacteristic(nullptr),
     _pPresetLoadCharacteristic(nullptr),
     _pPresetListCharacteristic(nullptr),
@@ -222,7 +223,8 @@ void BluetoothController::enable() {
             &_systemSettings,
             sizeof(SystemSettings),
             "system",
-            nullptr
+            nullptr,
+            SYSTEM_SETTINGS_V1_SIZE
         ));
 
         _pMidiCharacteristic = _pService->createCharacteristic(
@@ -282,6 +284,14 @@ void BluetoothController::enable() {
         );
         _pBatteryControlCharacteristic->setCallbacks(new BatteryControlCallback(this, _preferences));
 
+        // Performance Stats Characteristic (Read = latency summary, Write 0x01 = reset)
+        _pPerfStatsCharacteristic = _pService->createCharacteristic(
+            PERF_STATS_UUID,
+            BLECharacteristic::PROPERTY_READ |
+            BLECharacteristic::PROPERTY_WRITE
+        );
+        _pPerfStatsCharacteristic->setCallbacks(new PerfStatsCallback(this));
+
         // Preset Save Characteristic (Write)
         _pPresetSaveCharacteristic = _pService->createCharacteristic(
             PRESET_SAVE_UUID,
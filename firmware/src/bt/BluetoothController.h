@@ -55,6 +55,7 @@ public:
     BLECharacteristic* getFirmwareVersionCharacteristic() { return _pFirmwareVersionCharacteristic; }
     BLECharacteristic* getBatteryStatusCharacteristic() { return _pBatteryStatusCharacteristic; }
     BLECharacteristic* getBatteryControlCharacteristic() { return _pBatteryControlCharacteristic; }
+    BLECharacteristic* getPerfStatsCharacteristic() { return _pPerfStatsCharacteristic; }
     
     // Preset characteristic getters
     BLECharacteristic* getPresetSaveCharacteristic() { return _pPresetSaveCharacteristic; }
@@ -137,6 +138,7 @@ private:
     BLECharacteristic* _pFirmwareVersionCharacteristic;
     BLECharacteristic* _pBatteryStatusCharacteristic;
     BLECharacteristic* _pBatteryControlCharacteristic;  // For commands like reset/recalibrate
+    BLECharacteristic* _pPerfStatsCharacteristic;       // Latency histograms (read), reset (write)
     
     // Preset management characteristics
     BLECharacteristic* _pPresetSaveCharacteristic;
@@ -3,6 +3,7 @@
 #include <objects/Globals.h>
 #include <music/ScaleManager.h>
 #include <music/StrumPatterns.h>
+#include <midi/MidiLatency.h>
 #include <objects/Settings.h>
 #include <cstring>
 
@@ -12,8 +13,10 @@ GenericSettingsCallback::GenericSettingsCallback(
     void* dest,
     size_t destSize,
     const char* prefKey,
-    ScaleManager* scaleManager)
-    : _controller(controller), _preferences(preferences), _dest(dest), _destSize(destSize), _prefKey(prefKey), _scaleManager(scaleManager)
+    ScaleManager* scaleManager,
+    size_t legacySize)
+    : _controller(controller), _preferences(preferences), _dest(dest), _destSize(destSize), _prefKey(prefKey), _scaleManager(scaleManager),
+      _legacySize(legacySize)
 {
 }
 
@@ -25,15 +28,18 @@ void GenericSettingsCallback::onWrite(BLECharacteristic *pCharacteristic) {
         _controller->setActivityMode(CONFIGURATION);  // Settings write = config mode
     }
 
-    // Basic length check
-    if (rxValue.length() != _destSize) {
+    // Length check: the current layout or, where there is one, the exact
+    // legacy layout (which updates only the fields it covers). Any other
+    // length could end inside a field and persist half of it.
+    const size_t rxSize = rxValue.length();
+    if (rxSize != _destSize && (_legacySize == 0 || rxSize != _legacySize)) {
         SERIAL_PRINT("Invalid data length for ");
         SERIAL_PRINTLN(_prefKey.c_str());
         return;
     }
 
     // Perform copy and persist
-    memcpy(_dest, rxValue.data(), _destSize);
+    memcpy(_dest, rxValue.data(), rxSize);
     _preferences.putBytes(_prefKey.c_str(), _dest, _destSize);
 
     // Debug: Log lever settings updates to see stepSize
@@ -65,6 +71,7 @@ void GenericSettingsCallback::onWrite(BLECharacteristic *pCharacteristic) {
     // When chord settings change (e.g., strumSpeed), sync all levers
     // in case any are assigned to CC 200 (Strum Speed)
     else if (_prefKey == "chord") {
+        chordSettingsChanged();
         if (syncLever1Callback) syncLever1Callback();
         if (syncLeverPush1Callback) syncLeverPush1Callback();
         if (syncLever2Callback) syncLever2Callback();
@@ -108,7 +115,7 @@ void MidiSettingsCallback::onWrite(BLECharacteristic *pCharacteristic) {
             printCounter = (printCounter + 1) % 10;
 
             if (ccNumber >= 0 && ccNumber <= 127 && ccValue >= 0 && ccValue <= 127) {
-                MIDI.sendControlChange(ccNumber, ccValue, 1);
+                midiOut.postControlChange(ccNumber, ccValue, 1);  // BLE task: queue for musicEngineTask
             }
         }
     }
@@ -168,6 +175,30 @@ void StrumIntervalsCallback::onWrite(BLECharacteristic *pCharacteristic) {
     SERIAL_PRINTLN(length);
 }
 
+PerfStatsCallback::PerfStatsCallback(BluetoothController* controller)
+    : _controller(controller)
+{
+}
+
+void PerfStatsCallback::onRead(BLECharacteristic *pCharacteristic) {
+    // Format: see MidiLatencyStats::pack() (version, stage count, events, p50/p99/max per stage)
+    uint8_t packet[MidiLatencyStats::PACKET_SIZE];
+    size_t len = midiLatency.pack(packet);
+    pCharacteristic->setValue(packet, len);
+}
+
+void PerfStatsCallback::onWrite(BLECharacteristic *pCharacteristic) {
+    const std::string rxValue = pCharacteristic->getValue();
+
+    if (_controller) {
+        _controller->updateLastActivity();
+    }
+
+    if (rxValue.length() == 1 && static_cast<uint8_t>(rxValue[0]) == 0x01) {
+        midiLatency.requestReset();  // Applied by musicEngineTask, which owns the stats
+    }
+}
+
 BatteryControlCallback::BatteryControlCallback(BluetoothController* controller, Preferences& preferences)
     : _controller(controller), _preferences(preferences)
 {
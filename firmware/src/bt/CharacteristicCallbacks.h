@@ -17,7 +17,8 @@ public:
                             void* dest,
                             size_t destSize,
                             const char* prefKey,
-                            ScaleManager* scaleManager = nullptr);
+                            ScaleManager* scaleManager = nullptr,
+                            size_t legacySize = 0);  // Exact size of the one older layout also accepted (0 = none); it updates only the fields it covers
     void onWrite(BLECharacteristic *pCharacteristic) override;
 
 private:
@@ -27,6 +28,7 @@ private:
     size_t _destSize;
     std::string _prefKey;
     ScaleManager* _scaleManager;
+    size_t _legacySize;
 };
 
 // MIDI callback keeps original behavior for parsing CC strings
@@ -57,6 +59,16 @@ private:
     Preferences& _preferences;
 };
 
+// Performance stats callback: fills the latency packet on read, resets on write 0x01
+class PerfStatsCallback final : public BLECharacteristicCallbacks {
+public:
+    PerfStatsCallback(BluetoothController* controller);
+    void onRead(BLECharacteristic *pCharacteristic) override;
+    void onWrite(BLECharacteristic *pCharacteristic) override;
+private:
+    BluetoothController* _controller;
+};
+
 // Battery control callback for commands (reset/recalibrate)
 class BatteryControlCallback final : public BLECharacteristicCallbacks {
 public:
@@ -183,9 +183,11 @@ void PresetLoadCallback::onWrite(BLECharacteristic *pCharacteristic) {
         return;
     }
     PresetData data;
+    data.system = _system;  // Presets saved with an older SystemSettings keep the newer fields
     size_t dataSize = _preferences.getBytes(dataKey.c_str(), &data, sizeof(PresetData));
     
-    if (dataSize != sizeof(PresetData)) {
+    if (dataSize != sizeof(PresetData) &&
+        dataSize != sizeof(PresetData) - sizeof(SystemSettings) + SYSTEM_SETTINGS_V1_SIZE) {
         SERIAL_PRINTLN("Failed to load preset data");
         return;
     }
@@ -198,6 +200,7 @@ void PresetLoadCallback::onWrite(BLECharacteristic *pCharacteristic) {
     memcpy(&_touch, &data.touch, sizeof(TouchSettings));
     memcpy(&_scale, &data.scale, sizeof(ScaleSettings));
     memcpy(&_chord, &data.chord, sizeof(ChordSettings));
+    chordSettingsChanged();
     memcpy(&_system, &data.system, sizeof(SystemSettings));
     
     // Update scale manager
@@ -8,12 +8,65 @@
 #include <led/LEDController.h>
 #include <music/ScaleManager.h>
 #include <music/StrumPatterns.h>
+#include <music/ArpProgram.h>
+#include <midi/MidiLatency.h>
+#include <midi/NoteRefCounter.h>
+#include <objects/TimingWheel.h>
+#include <objects/VerticalDebouncer.h>
+
+// Key map reductions, evaluated at compile time over KeyboardControl::KEY_MAP
+struct KeyBitIndex {
+    int8_t key[32];  // Scan-word bit -> key index, -1 if not a key
+};
+
+template<size_t N>
+constexpr uint32_t keyMapPins(const KeyMapEntry (&map)[N]) {
+    uint32_t pins = 0;
+    for (size_t i = 0; i < N; ++i) pins |= map[i].mask;
+    return pins;
+}
+
+template<size_t N>
+constexpr KeyBitIndex keyMapIndex(const KeyMapEntry (&map)[N]) {
+    KeyBitIndex index{};
+    for (auto& k : index.key) k = -1;
+    for (size_t i = 0; i < N; ++i) index.key[map[i].bit] = (int8_t)i;
+    return index;
+}
 
 template<typename MidiTransport, typename OctaveControlType>
 class KeyboardControl {
 public:
+    // Hardware key layout, left to right. whiteKeyPos is the compact-mode
+    // degree: white keys count 0-11, black keys repeat their lower neighbour.
+    static constexpr KeyMapEntry KEY_MAP[MAX_KEYS] = {
+        {BANK_U1, 4, 59, 0},    // SW1 (B)
+        {BANK_U1, 14, 60, 1},   // SW2 (C)
+        {BANK_U1, 1, 61, 1},    // SB1 (C#)
+        {BANK_U1, 13, 62, 2},   // SW3 (D)
+        {BANK_U1, 2, 63, 2},    // SB2 (D#)
+        {BANK_U1, 12, 64, 3},   // SW4 (E)
+        {BANK_U1, 11, 65, 4},   // SW5 (F)
+        {BANK_U1, 0, 66, 4},    // SB3 (F#)
+        {BANK_U1, 10, 67, 5},   // SW6 (G)
+        {BANK_U1, 3, 68, 5},    // SB4 (G#)
+        {BANK_U1, 9, 69, 6},    // SW7 (A)
+        {BANK_U2, 14, 70, 6},   // SB5 (A#)
+        {BANK_U1, 8, 71, 7},    // SW8 (B)
+        {BANK_U2, 11, 72, 8},   // SW9 (C)
+        {BANK_U2, 13, 73, 8},   // SB6 (C#)
+        {BANK_U2, 10, 74, 9},   // SW10 (D)
+        {BANK_U2, 12, 75, 9},   // SB7 (D#)
+        {BANK_U2, 9, 76, 10},   // SW11 (E)
+        {BANK_U2, 8, 77, 11},   // SW12 (F)
+    };
+    static constexpr uint32_t KEY_PINS = keyMapPins(KEY_MAP);
+    static constexpr KeyBitIndex KEY_INDEX = keyMapIndex(KEY_MAP);
+    static_assert(__builtin_popcount(KEY_PINS) == MAX_KEYS, "two keys share an expander pin");
+
     KeyboardControl(MidiTransport& midi, OctaveControlType& octaveCtrl, ScaleManager& scaleManager, ChordSettings& chordSettings)
         : _midi(midi),
+          _notes(midi),
           _octaveControl(octaveCtrl),
           _scaleManager(scaleManager),
           _chordSettings(chordSettings),
@@ -23,12 +76,8 @@ public:
           _arpRootNote(0),
           _arpPattern(nullptr),
           _arpPatternLength(0),
-          _arpCurrentIndex(0),
-          _arpLastNoteTime(0),
+          _arpGeneration(0),
           _arpCurrentNote(-1),
-          _arpDirection(1),
-          _arpLastPattern(-1),
-          _arpShufflePos(0),
           _pitchBendOffset(0),
           _pitchBendOverlapUs(25000),
           _sustainActive(false),
@@ -36,55 +85,28 @@ public:
           _arpUserLatchPanicArmed(false),
           _strumActive(false),
           _activeStrumKey(0),
-          _strumInProgress(false),
-          _strumCount(0),
-          _strumCurrentIndex(0),
-          _strumLastNoteTime(0),
           _userArpCount(0)
     {
         memset(_isNoteOn, false, sizeof(_isNoteOn));
         memset(_baseNote, 0, sizeof(_baseNote));
         memset(_userArpNotes, 0, sizeof(_userArpNotes));
-        memset(_strumNotes, 0, sizeof(_strumNotes));
-        memset(_strumVelocities, 0, sizeof(_strumVelocities));
-        memset(_strumNoteOffTimes, 0, sizeof(_strumNoteOffTimes));
         memset(_activeChordNotes, 0, sizeof(_activeChordNotes));
         memset(_activeChordCount, 0, sizeof(_activeChordCount));
-        memset(_pbPendingOffNote, 0, sizeof(_pbPendingOffNote));
-        memset(_pbPendingOffDueUs, 0, sizeof(_pbPendingOffDueUs));
-        memset(_pbPendingOffActive, false, sizeof(_pbPendingOffActive));
-        memset(_sustainPendingOffNote, 0, sizeof(_sustainPendingOffNote));
-        memset(_sustainPendingOffDueUs, 0, sizeof(_sustainPendingOffDueUs));
-        memset(_sustainPendingOffActive, false, sizeof(_sustainPendingOffActive));
-
-        // Initialize keys array
-        _keys[0] = {59, 4, true, true, &mcp_U1, "SW1 (B)"};
-        _keys[1] = {60, 14, true, true, &mcp_U1, "SW2 (C)"};
-        _keys[2] = {61, 1, true, true, &mcp_U1, "SB1 (C#)"};
-        _keys[3] = {62, 13, true, true, &mcp_U1, "SW3 (D)"};
-        _keys[4] = {63, 2, true, true, &mcp_U1, "SB2 (D#)"};
-        _keys[5] = {64, 12, true, true, &mcp_U1, "SW4 (E)"};
-        _keys[6] = {65, 11, true, true, &mcp_U1, "SW5 (F)"};
-        _keys[7] = {66, 0, true, true, &mcp_U1, "SB3 (F#)"};
-        _keys[8] = {67, 10, true, true, &mcp_U1, "SW6 (G)"};
-        _keys[9] = {68, 3, true, true, &mcp_U1, "SB4 (G#)"};
-        _keys[10] = {69, 9, true, true, &mcp_U1, "SW7 (A)"};
-        _keys[11] = {70, 14, true, true, &mcp_U2, "SB5 (A#)"};
-        _keys[12] = {71, 8, true, true, &mcp_U1, "SW8 (B)"};
-        _keys[13] = {72, 11, true, true, &mcp_U2, "SW9 (C)"};
-        _keys[14] = {73, 13, true, true, &mcp_U2, "SB6 (C#)"};
-        _keys[15] = {74, 10, true, true, &mcp_U2, "SW10 (D)"};
-        _keys[16] = {75, 12, true, true, &mcp_U2, "SB7 (D#)"};
-        _keys[17] = {76, 9, true, true, &mcp_U2, "SW11 (E)"};
-        _keys[18] = {77, 8, true, true, &mcp_U2, "SW12 (F)"};
+        memset(_activeChordHeld, 0, sizeof(_activeChordHeld));
     }
 
     static constexpr unsigned long KEY_PRESS_DEBOUNCE_MS = 10;    // ms - keep fast for responsive press
     static constexpr unsigned long KEY_RELEASE_DEBOUNCE_MS = 30;   // ms - longer to survive BLE-induced I2C stalls
+    static_assert(KEY_RELEASE_DEBOUNCE_MS <= VerticalDebouncer::MAX_WINDOW_MS &&
+                  KEY_PRESS_DEBOUNCE_MS <= VerticalDebouncer::MAX_WINDOW_MS,
+                  "debounce windows must fit the vertical counters");
+    static_assert(MAX_KEYS <= 32, "key indices are tracked in 32-bit masks");
     static constexpr unsigned long ARP_USER_LATCH_PANIC_HOLD_MS = 900; // ms
+    static constexpr unsigned long ARP_POLL_US = 5000;  // Latched arp with no notes yet: recheck at scan rate
     static constexpr int MAX_CHORD_NOTES = 16;  // Support 3x voicing (5 notes × 3 octaves = 15)
-    static constexpr int MAX_PB_PENDING_OFFS = 24;
-    static constexpr int MAX_SUSTAIN_PENDING_OFFS = 128;
+    static_assert(MAX_CHORD_NOTES <= 16, "held chord notes are tracked in 16-bit masks");
+    static constexpr uint8_t STRUM_VOICES = 4;  // Strum cascades that can overlap (fast chord changes, two hands)
+    static_assert(MAX_CHORD_NOTES <= ArpProgram::MAX_SOURCE, "arp program must hold a full voicing");
 
     // Set the note overlap duration for pitch bend mode retriggers.
     // Called by LeverControls whenever the lever is in PITCH_BEND mode.
@@ -132,7 +154,7 @@ public:
                     int oldNote = constrain(quantized + oldOffset, 0, 127);
                     int newNote = constrain(quantized + semitones, 0, 127);
                     if (oldNote != newNote) {
-                        _midi.sendNoteOn(newNote, _currentVelocity, 1);
+                        _notes.noteOn(newNote, _currentVelocity, 1);
                         schedulePitchBendNoteOff(oldNote);
                     }
                 }
@@ -141,11 +163,13 @@ public:
     }
 
     void begin() {
+        _scheduler.reset(micros());
         memset(_keyPressStartMs, 0, sizeof(_keyPressStartMs));
         memset(_keyLongPressHandled, false, sizeof(_keyLongPressHandled));
         // Configure all pins as INPUT_PULLUP first
-        for (auto & key : _keys) {
-            key.mcp->pinMode(key.pin, INPUT_PULLUP);
+        for (const auto & key : KEY_MAP) {
+            Adafruit_MCP23X17& mcp = (key.bank() == BANK_U1) ? mcp_U1 : mcp_U2;
+            mcp.pinMode(key.pin(), INPUT_PULLUP);
         }
         
         // Then do ONE bulk read to initialize states (2 I2C transactions instead of 19)
@@ -155,19 +179,7 @@ public:
         initialCache.timestamp = micros();
         
         // Set initial states from bulk read
-        for (auto & key : _keys) {
-            bool raw;
-            if (key.mcp == &mcp_U1) {
-                raw = initialCache.isU1PinLow(key.pin);
-            } else {  // key.mcp == &mcp_U2
-                raw = initialCache.isU2PinLow(key.pin);
-            }
-            key.lastReading = raw;
-            key.debouncedState = raw;
-            key.state = raw;
-            key.prevState = raw;
-            key.lastDebounceTime = millis();
-        }
+        _debouncer.reset(initialCache.lowMask() & KEY_PINS, millis());
         
         resetAllKeys();
     }
@@ -181,13 +193,10 @@ public:
             int quantizedNote;
             
             // Check if compact mode and we have a valid key index
-            if (_scaleManager.getKeyMapping() == 1 && keyIndex >= 0) {
+            if (_scaleManager.getKeyMapping() == 1 && keyIndex >= 0 && keyIndex < MAX_KEYS) {
                 // Compact mode: map white keys to sequential scale degrees
                 // Black keys repeat their lower adjacent white key (same note, parallel octave behaviour)
-                int whiteKeyPosition = getWhiteKeyPosition(keyIndex);
-                if (whiteKeyPosition < 0) {
-                    whiteKeyPosition = getBlackKeyLowerWhitePosition(keyIndex);
-                }
+                int whiteKeyPosition = KEY_MAP[keyIndex].whiteKeyPos;
                 if (whiteKeyPosition >= 0) {
                     quantizedNote = _scaleManager.getCompactModeNote(whiteKeyPosition) + (_octaveControl.getOctave() * 12);
                 } else {
@@ -200,7 +209,7 @@ public:
             }
             
             int bentNote = constrain(quantizedNote + _pitchBendOffset, 0, 127);
-            _midi.sendNoteOn(bentNote, _currentVelocity, channel);
+            _notes.noteOn(bentNote, _currentVelocity, channel);
             char buf[16];
             snprintf(buf, sizeof(buf), "N%dv%d", bentNote, _currentVelocity);
             SERIAL_PRINTLN(buf);
@@ -224,11 +233,10 @@ public:
                 // If arpeggiator is already running, smoothly transition to new root note
                 // Keep current index to continue pattern seamlessly
                 bool wasAlreadyRunning = _arpActive;
-                int previousIndex = _arpCurrentIndex;
                 
                 // Stop currently playing note (if any)
                 if (_arpCurrentNote >= 0) {
-                    _midi.sendNoteOff(_arpCurrentNote, 0, 1);
+                    _notes.noteOff(_arpCurrentNote, 0, 1);
                     SERIAL_PRINT("Arp Note Off (interrupted): ");
                     SERIAL_PRINTLN(_arpCurrentNote);
                 }
@@ -270,37 +278,20 @@ public:
                     _arpUserLatchPanicArmed = false;
                 }
                 
-                // Keep current index if already running, otherwise start from beginning
+                // Keep the program's place if already running, otherwise start from the beginning
                 if (!wasAlreadyRunning) {
-                    int p = _chordSettings.strumPattern;
-                    if (p == 2) {
-                        _arpCurrentIndex = intervalCount > 0 ? intervalCount - 1 : 0;
-                        _arpDirection = -1;
-                    } else if (p == 4) {
-                        generateArpContract(intervalCount);
-                        _arpDirection = 1;
-                    } else if (p == 5) {
-                        generateArpExpand(intervalCount);
-                        _arpDirection = 1;
-                    } else if (p == 6) {
-                        // Random: generate a fresh shuffle on every new key press
-                        generateArpShuffle(intervalCount);
-                        _arpDirection = 1;
-                    } else {
-                        _arpCurrentIndex = 0;
-                        _arpDirection = 1;
-                    }
-                    _arpLastPattern = p;
+                    // Recompiled at the first step (a fresh shuffle for random)
+                    _arpProgram.invalidate();
+                    // First step on the next scan; each step schedules the one after it
+                    _arpGeneration++;
+                    scheduleEvent(micros(), EV_ARP_STEP, 0, _arpGeneration, true);
                     char buf[16];
                     snprintf(buf, sizeof(buf), "Arp:R%dP%d", rootNote, _chordSettings.strumPattern);
                     SERIAL_PRINTLN(buf);
                 } else {
-                    // Continue from current position, adjust if pattern length changed
-                    if (_arpCurrentIndex >= intervalCount) {
-                        _arpCurrentIndex = 0;
-                    }
+                    // Continue from the current step (the program wraps it if the pattern got shorter)
                     char buf[20];
-                    snprintf(buf, sizeof(buf), "ArpRoot:%d@%d", rootNote, _arpCurrentIndex);
+                    snprintf(buf, sizeof(buf), "ArpRoot:%d@%d", rootNote, _arpProgram.position());
                     SERIAL_PRINTLN(buf);
                 }
                 
@@ -311,55 +302,46 @@ public:
                 // BASIC STRUM or CHORD: Play once
                 
                 if (_chordSettings.strumEnabled) {
-                    // BASIC STRUM MODE: Non-blocking monophonic strum
-                    // Stop previous strum if one is in progress (immediate interrupt)
-                    if (_strumInProgress) {
-                        stopStrum();
-                    }
+                    // BASIC STRUM MODE: Non-blocking strum on its own cascade voice,
+                    // so strums started on other keys keep playing alongside it
                     
                     // Mark this strum as active
                     _strumActive = true;
                     _activeStrumKey = note;
                     _activeChordCount[note] = intervalCount;
+                    StrumVoice& voice = allocateStrumVoice(note);
                     
                     // Prepare strum notes (non-blocking - will play over time)
                     // Determine direction based on speed sign (negative = reverse)
                     bool reverse = _chordSettings.strumSpeed < 0;
                     
                     // Build list of notes and velocities to play
-                    _strumCount = intervalCount;
+                    voice.count = intervalCount;
                     for (int i = 0; i < intervalCount; i++) {
                         // Get note index (reverse order if speed is negative)
                         int noteIndex = reverse ? (intervalCount - 1 - i) : i;
                         int chordNote = rootNote + intervals[noteIndex];
                         int velocity = calculateChordVelocity(noteIndex, intervalCount);
                         
-                        _strumNotes[i] = chordNote;
-                        _strumVelocities[i] = velocity;
-                        _activeChordNotes[note][noteIndex] = chordNote;
+                        voice.notes[i] = chordNote;
+                        voice.velocities[i] = velocity;
+                        _activeChordNotes[note][i] = chordNote;  // Strum order, as the voice plays them
                     }
                     
-                    // Start strum playback (first note plays immediately)
-                    _strumInProgress = true;
-                    _strumCurrentIndex = 0;
-                    _strumLastNoteTime = millis();
-                    
                     // Play first note immediately
-                    _midi.sendNoteOn(_strumNotes[0], _strumVelocities[0], channel);
+                    chordNoteOn(note, 0, voice.velocities[0]);
                     char buf[24];
-                    snprintf(buf, sizeof(buf), "S0:N%dv%d", _strumNotes[0], _strumVelocities[0]);
+                    snprintf(buf, sizeof(buf), "S0:N%dv%d", voice.notes[0], voice.velocities[0]);
                     SERIAL_PRINTLN(buf);
                     
-                    _strumCurrentIndex = 1;  // Next note to play
+                    voice.index = 1;  // Next note to play
+                    scheduleEvent(micros() + strumStepDelayMs(1) * 1000UL, EV_STRUM_STEP, 0, strumTag(voice), true);
                 } else {
                     // CHORD MODE: Monophonic (like strum mode)
                     // Stop previous chord if one is active
                     if (_strumActive && _activeStrumKey != note) {
                         // Kill all notes from previous chord
-                        for (int i = 0; i < _activeChordCount[_activeStrumKey]; i++) {
-                            _midi.sendNoteOff(_activeChordNotes[_activeStrumKey][i], 0, 1);
-                        }
-                        _activeChordCount[_activeStrumKey] = 0;
+                        releaseChord(_activeStrumKey, false);
                         _isNoteOn[_activeStrumKey] = false;
                     }
                     
@@ -376,7 +358,7 @@ public:
                         int velocity = calculateChordVelocity(i, intervalCount);
                         _activeChordNotes[note][i] = chordNote;
                         
-                        _midi.sendNoteOn(chordNote, velocity, channel);
+                        chordNoteOn(note, i, velocity);
                         SERIAL_PRINT("Chord Note ");
                         SERIAL_PRINT(i);
                         SERIAL_PRINT(" On: ");
@@ -391,7 +373,7 @@ public:
         }
     }
 
-    void stopMidiNote(const byte note, int keyIndex = -1) {
+    void stopMidiNote(const byte note) {
         // If arpeggiator is active, handle based on latch mode
         if (_arpActive) {
             _isNoteOn[note] = false;
@@ -434,7 +416,7 @@ public:
                                 if (newRoot != _arpRootNote) {
                                     // Cut current note and retarget root
                                     if (_arpCurrentNote >= 0) {
-                                        _midi.sendNoteOff(_arpCurrentNote, 0, 1);
+                                        _notes.noteOff(_arpCurrentNote, 0, 1);
                                         _arpCurrentNote = -1;
                                     }
                                     _arpRootNote = newRoot;
@@ -461,27 +443,9 @@ public:
             constexpr byte channel = 1;
             
             if (_chordSettings.playMode == PlayMode::SCALE) {
-                // Original scale mode behavior
-                int quantizedNote;
-                
-                // Check if compact mode and we have a valid key index
-                if (_scaleManager.getKeyMapping() == 1 && keyIndex >= 0) {
-                    // Compact mode: map white keys to sequential scale degrees
-                    // Black keys repeat their lower adjacent white key (same note, parallel octave behaviour)
-                    int whiteKeyPosition = getWhiteKeyPosition(keyIndex);
-                    if (whiteKeyPosition < 0) {
-                        whiteKeyPosition = getBlackKeyLowerWhitePosition(keyIndex);
-                    }
-                    if (whiteKeyPosition >= 0) {
-                        quantizedNote = _scaleManager.getCompactModeNote(whiteKeyPosition) + (_octaveControl.getOctave() * 12);
-                    } else {
-                        // Fallback: quantize normally
-                        quantizedNote = _scaleManager.quantizeNote(note + _octaveControl.getOctave() * 12);
-                    }
-                } else {
-                    // Natural mode: quantize to nearest scale note
-                    quantizedNote = _scaleManager.quantizeNote(note + _octaveControl.getOctave() * 12);
-                }
+                // Release the note this key's press started (octave or scale
+                // may have changed since), at the current bend
+                int quantizedNote = _baseNote[note];
                 
                 int bentNote = constrain(quantizedNote + _pitchBendOffset, 0, 127);
                 if (_sustainActive) {
@@ -491,7 +455,7 @@ public:
                     snprintf(buf, sizeof(buf), "N%d~", bentNote); // ~ = delayed by sustain timer
                     SERIAL_PRINTLN(buf);
                 } else {
-                    _midi.sendNoteOff(bentNote, 0, channel);
+                    _notes.noteOff(bentNote, 0, channel);
                     char buf[16];
                     snprintf(buf, sizeof(buf), "N%d-", bentNote);
                     SERIAL_PRINTLN(buf);
@@ -499,20 +463,11 @@ public:
             } else {
                 // Chord mode - use chromatic notes (no scale quantization)
                 
-                // If this is the active strum key and strum is in progress, stop cascade
-                if (_strumActive && _activeStrumKey == note && _strumInProgress) {
-                    stopStrum();
-                }
+                // Stop this key's strum cascade if it is still running
+                stopStrum(note);
                 
                 // Stop all chord notes
-                for (int i = 0; i < _activeChordCount[note]; i++) {
-                    int chordNote = _activeChordNotes[note][i];
-                    _midi.sendNoteOff(chordNote, 0, channel);
-                    char buf[16];
-                    snprintf(buf, sizeof(buf), "C%d-", chordNote);
-                    SERIAL_PRINTLN(buf);
-                }
-                _activeChordCount[note] = 0;
+                releaseChord(note, true);
                 
                 // Clear strum active flag if this was the active strum key
                 if (_strumActive && _activeStrumKey == note) {
@@ -554,14 +509,15 @@ public:
     void registerVelocityChangeHook(void (*hook)(int)) { _velocityChangeHook = hook; }
 
     void resetAllKeys() {
-        for (int i = 0; i < 128; ++i) {
-            _midi.sendNoteOff(i, 0, 1);
-            if (_isNoteOn[i]) {
-                _isNoteOn[i] = false;
-            }
-        }
+        _notes.allNotesOff(1);
+        memset(_isNoteOn, false, sizeof(_isNoteOn));
+        memset(_activeChordCount, 0, sizeof(_activeChordCount));
+        memset(_activeChordHeld, 0, sizeof(_activeChordHeld));
     }
 
+    // Note holders (merged NoteOns, stray NoteOffs) for the serial diagnostics line
+    const NoteRefCounter<MidiTransport>& notes() const { return _notes; }
+
     // Stop arpeggiator and silence current note (clean cutoff)
     void stopArpeggiator() {
         if (!_arpActive) {
@@ -570,20 +526,19 @@ public:
         
         // Turn off current note if any
         if (_arpCurrentNote >= 0) {
-            _midi.sendNoteOff(_arpCurrentNote, 0, 1);
+            _notes.noteOff(_arpCurrentNote, 0, 1);
             char buf[16];
             snprintf(buf, sizeof(buf), "Arp:Stop%d", _arpCurrentNote);
             SERIAL_PRINTLN(buf);
         }
         
-        // Clear arp state
+        // Clear arp state (pending step events go stale)
         _arpActive = false;
+        _arpGeneration++;
         _arpRootNote = 0;
         _arpPattern = nullptr;
         _arpPatternLength = 0;
-        _arpCurrentIndex = 0;
-        _arpDirection = 1;
-        _arpLastPattern = -1;
+        _arpProgram.invalidate();
         _arpCurrentNote = -1;
         
         // Clear user sequence
@@ -592,70 +547,19 @@ public:
     }
 
     void updateKeyboardState(const GPIOCache& gpioCache) {
-        // Process delayed note-offs for pitch bend overlap smoothing.
-        processPendingPitchBendNoteOffs();
-        // Process delayed note-offs scheduled by sustain timing mode.
-        processPendingSustainNoteOffs();
-
-        // Update arpeggiator (for advanced strum looping)
-        updateArpeggiator();
-        
-        // Update basic strum (non-blocking cascade)
-        updateStrum();
-
-        unsigned long nowMs = millis();
-        
-        // Debounced key scanning (using cached GPIO states, zero I2C overhead)
-        for (int i = 0; i < MAX_KEYS; ++i) {
-            auto & key = _keys[i];
-            
-            // Extract pin state from cache based on which MCP this key is on
-            bool raw;
-            if (key.mcp == &mcp_U1) {
-                raw = gpioCache.isU1PinLow(key.pin);
-            } else {  // key.mcp == &mcp_U2
-                raw = gpioCache.isU2PinLow(key.pin);
-            };
-            if (raw != key.lastReading) {
-                key.lastDebounceTime = nowMs;
-                key.lastReading = raw;
-            }
-
-            unsigned long debounceMs = raw ? KEY_PRESS_DEBOUNCE_MS : KEY_RELEASE_DEBOUNCE_MS;
-            if ((nowMs - key.lastDebounceTime) >= debounceMs) {
-                if (raw != key.debouncedState) {
-                    key.debouncedState = raw;
-                    if (key.debouncedState) {
-                        _keyPressStartMs[i] = nowMs;
-                        _keyLongPressHandled[i] = false;
-                        playMidiNote(key.midi, i);  // Pass key index
-                    } else {
-                        bool isLongPressRelease =
-                            _keyPressStartMs[i] > 0 &&
-                            (nowMs - _keyPressStartMs[i]) >= ARP_USER_LATCH_PANIC_HOLD_MS;
-
-                        _keyPressStartMs[i] = 0;
-
-                        // Release-edge panic: consume release after long hold in USER+LATCH ARP.
-                        if (!_keyLongPressHandled[i] && isLongPressRelease &&
-                            _arpUserLatchPanicArmed &&
-                            _arpActive &&
-                            _chordSettings.playMode == PlayMode::ARP &&
-                            _chordSettings.arpUserMode == 1 &&
-                            _chordSettings.arpLatchMode == 1) {
-                            _keyLongPressHandled[i] = true;
-                            SERIAL_PRINTLN("Arp:PanicLP");
-                            stopArpeggiator();
-                        } else {
-                            _keyLongPressHandled[i] = false;
-                            stopMidiNote(key.midi, i);  // Pass key index
-                        }
-                    }
-                }
-            }
-
-            key.prevState = key.state;
-            key.state = key.debouncedState;
+        // Fire everything now due: pitch bend overlap and sustain NoteOffs,
+        // strum cascade steps and their NoteOffs, arpeggiator steps
+        processScheduledEvents();
+
+        // Time of the snapshot, not of this call: a snapshot that waited in
+        // the scanner's event ring is debounced as of when it was read
+        unsigned long nowMs = millis() - (micros() - gpioCache.timestamp) / 1000;
+
+        // Debounce the key pins (cached GPIO states, zero I2C overhead). Most
+        // scans see an unchanged snapshot with nothing settling: no work here.
+        const uint32_t flipped = _debouncer.update(gpioCache.lowMask() & KEY_PINS, nowMs);
+        if (flipped | _debouncer.edges()) {
+            handleKeyChanges(flipped, gpioCache.timestamp, nowMs);
         }
 
         // Panic stop for runaway ARP: long-press any held key in USER + LATCH mode.
@@ -669,7 +573,7 @@ public:
             }
 
             for (int i = 0; i < MAX_KEYS; ++i) {
-                if (_keys[i].debouncedState &&
+                if ((_debouncer.stable() & KEY_MAP[i].mask) &&
                     _arpUserLatchPanicArmed &&
                     !_keyLongPressHandled[i] &&
                     _keyPressStartMs[i] > 0 &&
@@ -683,105 +587,56 @@ public:
         }
     }
 
+    // Milliseconds until the earliest pending debounce decision (a key whose
+    // raw reading differs from its debounced state), or -1 if none is pending.
+    // Lets an event-driven scanner wake exactly when a press can be accepted.
+    long debounceWaitMs() const {
+        return _debouncer.waitMs();
+    }
+
+    // Bit mask of the key pins on one expander (for interrupt-on-change setup)
+    static constexpr uint16_t keyPinMask(ExpanderBank bank) {
+        return (uint16_t)(KEY_PINS >> (bank * 16));
+    }
+
     // Return true if any key is currently pressed (debounced state)
     bool anyKeyActive() const {
-        for (const auto & key : _keys) {
-            if (key.debouncedState) return true;
-        }
-        return false;
+        return _debouncer.stable() != 0;
     }
 
-    // Stop current strum in progress (for immediate interrupt)
-    void stopStrum() {
-        if (!_strumInProgress) {
-            return;
+    // Stop the strum cascade started by key, if it is still running
+    void stopStrum(byte key) {
+        for (auto& voice : _strumVoices) {
+            if (voice.inProgress && voice.key == key) {
+                stopStrumVoice(voice);
+            }
         }
-        
-        // No note-offs needed - we let notes ring until key release
-        // Just stop the cascade
-        _strumInProgress = false;
-        _strumCurrentIndex = 0;
-        _strumCount = 0;
     }
     
-    // Update basic strum state (non-blocking cascade playback)
-    void updateStrum() {
-        if (!_strumInProgress || _strumCurrentIndex >= _strumCount) {
-            if (_strumInProgress) {
-                _strumInProgress = false;  // Strum complete
-            }
-            return;
-        }
-        
-        unsigned long now = millis();
-        
-        // Check if any currently playing notes need to be turned off (scheduled release timing)
-        for (int i = 0; i < _strumCurrentIndex; i++) {
-            if (_strumNoteOffTimes[i] > 0 && now >= _strumNoteOffTimes[i]) {
-                _midi.sendNoteOff(_strumNotes[i], 0, 1);
-                char buf[16];
-                snprintf(buf, sizeof(buf), "S%d-off", i);
-                SERIAL_PRINTLN(buf);
-                _strumNoteOffTimes[i] = 0;  // Mark as handled
-            }
-        }
-        
-        // Calculate delay for this note.
-        // Repurpose gateValue as CHORD swing amount:
-        //   gate=10  -> straight 50/50 split
-        //   gate=100 -> triplet-like 66/33 split
-        // Note: this does not alter touch-control "Gate" mode naming/behavior.
-        // This is independent from ARP swing (strumSwing), which is handled in updateArpeggiator().
+    // Calculate delay before strum note noteIndex.
+    // Repurpose gateValue as CHORD swing amount:
+    //   gate=10  -> straight 50/50 split
+    //   gate=100 -> triplet-like 66/33 split
+    // Note: this does not alter touch-control "Gate" mode naming/behavior.
+    // This is independent from ARP swing (strumSwing), which ArpProgram applies.
+    // In integers: the long fraction 0.5 + (gate-10)/540 is (260+gate)/540,
+    // the short one (280-gate)/540, and the delay is 2*base*fraction.
+    unsigned long strumStepDelayMs(int noteIndex) const {
         int baseDelay = abs(_chordSettings.strumSpeed);
-        auto calculateStepDelay = [&](int noteIndex) -> int {
-            int clampedGate = _chordSettings.gateValue;
-            if (clampedGate < 10) clampedGate = 10;
-            if (clampedGate > 100) clampedGate = 100;
-
-            float swingT = (clampedGate - 10.0f) / 90.0f;     // 0..1
-            float longFraction = 0.5f + swingT * (1.0f / 6.0f); // 0.5 .. 0.6667
-            float shortFraction = 1.0f - longFraction;          // 0.5 .. 0.3333
-
-            bool isOffBeat = (noteIndex % 2) == 1;
-            float pairFraction = isOffBeat ? shortFraction : longFraction;
-            int delay = (int)(2.0f * baseDelay * pairFraction);
-
-            if (delay < 4) delay = 4;
-            return delay;
-        };
-        int noteDelay = calculateStepDelay(_strumCurrentIndex);
-        
-        // Check if enough time has passed to play next note
-        if (now - _strumLastNoteTime >= (unsigned long)noteDelay) {
-            // Play current note
-            _midi.sendNoteOn(_strumNotes[_strumCurrentIndex], _strumVelocities[_strumCurrentIndex], 1);
-            char buf[24];
-            snprintf(buf, sizeof(buf), "S%d:N%dv%d", _strumCurrentIndex, _strumNotes[_strumCurrentIndex], _strumVelocities[_strumCurrentIndex]);
-            SERIAL_PRINTLN(buf);
-            
-            // Hold each note until just before the next strum step so timing feel comes from
-            // swing (onset spacing), not forced staccato note duration.
-            int nextIndex = _strumCurrentIndex + 1;
-            int nextStepDelay = (nextIndex < _strumCount)
-                ? calculateStepDelay(nextIndex)
-                : noteDelay;
-
-            unsigned long noteDuration = (nextStepDelay > 1) ? (unsigned long)(nextStepDelay - 1) : 1UL;
-            _strumNoteOffTimes[_strumCurrentIndex] = now + noteDuration;
-            
-            // Move to next note
-            _strumCurrentIndex++;
-            _strumLastNoteTime = now;
-            
-            // Check if strum is complete
-            if (_strumCurrentIndex >= _strumCount) {
-                _strumInProgress = false;
-            }
-        }
+        int clampedGate = _chordSettings.gateValue;
+        if (clampedGate < 10) clampedGate = 10;
+        if (clampedGate > 100) clampedGate = 100;
+
+        bool isOffBeat = (noteIndex % 2) == 1;
+        int pairFraction540 = isOffBeat ? 280 - clampedGate : 260 + clampedGate;  // 270..180 / 270..360
+        int delay = baseDelay * pairFraction540 / 270;
+
+        if (delay < 4) delay = 4;
+        return (unsigned long)delay;
     }
     
-    // Update arpeggiator state (called from updateKeyboardState)
-    void updateArpeggiator() {
+    // Arpeggiator step (scheduled by the previous step, or by the key press that started it)
+    void onArpStep(unsigned long dueUs) {
         if (!_arpActive) {
             return;
         }
@@ -789,359 +644,293 @@ public:
         // Check if we're in ARP USER mode (user note sequence) or CHORD pattern mode
         bool isArpUserMode = (_chordSettings.playMode == PlayMode::ARP && _chordSettings.arpUserMode == 1);
         
-        // Exit if no valid pattern/sequence available
-        if (isArpUserMode) {
-            if (_userArpCount == 0) return;  // No notes in user sequence yet
-        } else {
-            if (!_arpPattern || _arpPatternLength == 0) return;  // No pattern available
-        }
-
-        unsigned long now = millis();
-        
-        // Calculate step delay based on strum speed
-        int baseDelay = abs(_chordSettings.strumSpeed);
-        int noteDelay = baseDelay;
-        
-        // Apply swing to odd-indexed notes in ALL ARP modes (CHORD and USER)
-        if (_chordSettings.strumSwing > 0 && (_arpCurrentIndex % 2) == 1) {
-            int swingDelay = (baseDelay * _chordSettings.strumSwing) / 200;
-            noteDelay += swingDelay;
-        }
-        
-        // Check if it's time for the next note
-        if (now - _arpLastNoteTime < (unsigned long)noteDelay) {
+        // No valid pattern/sequence available yet: check again in one scan period
+        bool hasNotes = isArpUserMode ? (_userArpCount > 0) : (_arpPattern && _arpPatternLength > 0);
+        if (!hasNotes) {
+            scheduleEvent(micros() + ARP_POLL_US, EV_ARP_STEP, 0, _arpGeneration, true);
             return;
         }
         
         // Turn off previous note
         if (_arpCurrentNote >= 0) {
-            _midi.sendNoteOff(_arpCurrentNote, 0, 1);
+            _notes.noteOff(_arpCurrentNote, 0, 1);
             char buf[16];
             snprintf(buf, sizeof(buf), "Arp-%d", _arpCurrentNote);
             SERIAL_PRINTLN(buf);
         }
         
-        // Play next note in pattern
-        if (isArpUserMode && _userArpCount > 0) {
-            int pat = _chordSettings.strumPattern;
-
-            if (pat == 5 || _userArpCount == 1) {
-                // strumPattern 5 = USER PRESS ORDER (cross-arrows icon): play in key-press order
-                int noteIndex = _arpCurrentIndex % _userArpCount;
-                _arpCurrentNote = _userArpNotes[noteIndex];
-                int velocity = calculateChordVelocity(noteIndex, _userArpCount);
-
-                _midi.sendNoteOn(_arpCurrentNote, velocity, 1);
-                char buf[24];
-                snprintf(buf, sizeof(buf), "ArpU%d:N%dv%d", noteIndex, _arpCurrentNote, velocity);
-                SERIAL_PRINTLN(buf);
+        // Play the next step of the compiled program, rebuilding it first if
+        // the pattern, notes, voicing, velocity or swing changed
+        ArpProgram::Inputs in;
+        in.user = isArpUserMode;
+        in.pattern = _chordSettings.strumPattern;
+        in.count = (uint8_t)min(isArpUserMode ? _userArpCount : _arpPatternLength, (int)ArpProgram::MAX_SOURCE);
+        for (uint8_t i = 0; i < in.count; i++) {
+            in.source[i] = isArpUserMode ? _userArpNotes[i] : _arpPattern[i];
+        }
+        in.velocity = _currentVelocity;
+        in.spread = _chordSettings.velocitySpread;
+        in.speedMs = abs(_chordSettings.strumSpeed);
+        in.swing = _chordSettings.strumSwing;
+        if (!_arpProgram.matches(in)) {
+            _arpProgram.compile(in, [this](int index, int count) { return calculateChordVelocity(index, count); });
+        }
 
-                _arpLastNoteTime = now;
-                _arpCurrentIndex++;
-                if (_arpCurrentIndex >= _userArpCount) {
-                    _arpCurrentIndex = 0;
-                    SERIAL_PRINTLN("ArpU:Loop");
-                }
-            } else {
-                // PITCH-SORTED PATTERNS: sort held notes by pitch, then apply direction
-                // Patterns: 1=up, 2=down, 3=updown ping-pong, 6=random, 7=edges-to-center
-                int sortedNotes[8];
-                int sortedCount = _userArpCount;
-                memcpy(sortedNotes, _userArpNotes, sortedCount * sizeof(int));
-
-                // Insertion sort ascending by pitch (max 8 notes, cheap)
-                for (int i = 1; i < sortedCount; i++) {
-                    int key = sortedNotes[i];
-                    int j = i - 1;
-                    while (j >= 0 && sortedNotes[j] > key) {
-                        sortedNotes[j + 1] = sortedNotes[j];
-                        j--;
-                    }
-                    sortedNotes[j + 1] = key;
-                }
+        const ArpProgram::Step& step = _arpProgram.next();
+        _arpCurrentNote = (isArpUserMode ? 0 : _arpRootNote) + step.pitch;
+        _notes.noteOn(_arpCurrentNote, step.velocity, 1);
+        char buf[24];
+        snprintf(buf, sizeof(buf), isArpUserMode ? "ArpU%d:N%dv%d" : "Arp%d:N%dv%d", step.index, _arpCurrentNote,
+                 step.velocity);
+        SERIAL_PRINTLN(buf);
+        if (_arpProgram.position() == 0) {
+            SERIAL_PRINTLN("Arp:Loop");
+        }
 
-                // For Contract (pat==4) and edges-to-center (pat==7), reorder: alternate outer notes inward
-                // e.g. [C3,E3,G3,B3] -> [C3,B3,E3,G3]
-                if (pat == 4 || pat == 7) {
-                    int reordered[8];
-                    int lo = 0, hi = sortedCount - 1, k = 0;
-                    while (lo <= hi) {
-                        reordered[k++] = sortedNotes[lo++];
-                        if (lo <= hi) reordered[k++] = sortedNotes[hi--];
-                    }
-                    memcpy(sortedNotes, reordered, sortedCount * sizeof(int));
-                }
+        // Schedule the next step from this step's due time (scan jitter doesn't accumulate)
+        unsigned long nextStepUs = dueUs + (unsigned long)step.delayMs * 1000UL;
+        if ((long)(nextStepUs - micros()) < 0) nextStepUs = micros();
+        scheduleEvent(nextStepUs, EV_ARP_STEP, 0, _arpGeneration, true);
+    }
 
-                // Clamp index in case note count changed while playing
-                if (_arpCurrentIndex >= sortedCount) _arpCurrentIndex = 0;
-
-                // Reset direction/index on pattern change
-                if (pat != _arpLastPattern) {
-                    _arpLastPattern = pat;
-                    if (pat == 2) {
-                        _arpCurrentIndex = sortedCount > 0 ? sortedCount - 1 : 0;
-                        _arpDirection = -1;
-                    } else if (pat == 6) {
-                        generateArpShuffle(sortedCount);
-                        _arpDirection = 1;
-                    } else {
-                        _arpCurrentIndex = 0;
-                        _arpDirection = 1;
-                    }
-                }
+    // Sequencer clock entry point: fire everything due now. Called by
+    // seqClockTask when its timer expires, in addition to every scan.
+    void runScheduler() {
+        processScheduledEvents();
+    }
 
-                // Determine which note to play
-                int noteIndex;
-                if (pat == 6) {
-                    // Random (shuffle): play from pre-generated shuffle, re-shuffle on loop
-                    if (_arpShufflePos >= sortedCount) {
-                        generateArpShuffle(sortedCount);
-                    }
-                    noteIndex = _arpShuffleBuffer[_arpShufflePos++];
-                } else {
-                    noteIndex = _arpCurrentIndex;
-                }
-                if (noteIndex < 0) noteIndex = 0;
-                if (noteIndex >= sortedCount) noteIndex = sortedCount - 1;
-
-                _arpCurrentNote = sortedNotes[noteIndex];
-                int velocity = calculateChordVelocity(noteIndex, sortedCount);
-                _midi.sendNoteOn(_arpCurrentNote, velocity, 1);
-                char buf[32];
-                snprintf(buf, sizeof(buf), "ArpS%d(p%d):N%dv%d", noteIndex, pat, _arpCurrentNote, velocity);
-                SERIAL_PRINTLN(buf);
+    // Exact time of the next scheduled event, for arming the sequencer clock
+    bool nextEventDueUs(unsigned long& dueUs) const {
+        return _scheduler.nextDueUs(dueUs);
+    }
 
-                _arpLastNoteTime = now;
-
-                // Advance index for non-random patterns
-                if (pat != 6) {
-                    if (pat == 2) {
-                        // Down: decrement, wrap
-                        _arpCurrentIndex--;
-                        if (_arpCurrentIndex < 0) _arpCurrentIndex = sortedCount - 1;
-                    } else if (pat == 3) {
-                        // Up-Down ping-pong
-                        _arpCurrentIndex += _arpDirection;
-                        if (_arpCurrentIndex >= sortedCount) {
-                            _arpDirection = -1;
-                            _arpCurrentIndex = max(0, sortedCount - 2);
-                        } else if (_arpCurrentIndex < 0) {
-                            _arpDirection = 1;
-                            _arpCurrentIndex = min(1, sortedCount - 1);
-                        }
-                    } else {
-                        // Up (pat 1), Contract (pat 4), edges-to-center (pat 7): increment linearly
-                        _arpCurrentIndex++;
-                        if (_arpCurrentIndex >= sortedCount) _arpCurrentIndex = 0;
-                    }
-                }
-            }
-        } else {
-            // CHORD mode: Calculate note from root + interval
-            int interval = _arpPattern[_arpCurrentIndex];
-            _arpCurrentNote = _arpRootNote + interval;
-            int velocity = calculateChordVelocity(_arpCurrentIndex, _arpPatternLength);
-            
-            _midi.sendNoteOn(_arpCurrentNote, velocity, 1);
-            char buf[24];
-            snprintf(buf, sizeof(buf), "Arp%d:N%dv%d", _arpCurrentIndex, _arpCurrentNote, velocity);
-            SERIAL_PRINTLN(buf);
-            
-            _arpLastNoteTime = now;
-            
-            // Advance index based on strumPattern direction mode
-            // Detect pattern change and reset direction/index
-            int pat = _chordSettings.strumPattern;
-            if (pat != _arpLastPattern) {
-                _arpLastPattern = pat;
-                if (pat == 2) {
-                    _arpCurrentIndex = _arpPatternLength > 0 ? _arpPatternLength - 1 : 0;
-                    _arpDirection = -1;
-                } else if (pat == 4) {
-                    generateArpContract(_arpPatternLength);
-                    _arpDirection = 1;
-                } else if (pat == 5) {
-                    generateArpExpand(_arpPatternLength);
-                    _arpDirection = 1;
-                } else if (pat == 6) {
-                    generateArpShuffle(_arpPatternLength);
-                    _arpDirection = 1;
-                } else {
-                    _arpCurrentIndex = 0;
-                    _arpUserLatchPanicArmed = false;
-                    _arpDirection = 1;
-                }
-            } else if (pat == 2) {
-                // Down: decrement and wrap
-                _arpCurrentIndex--;
-                if (_arpCurrentIndex < 0) {
-                    _arpCurrentIndex = _arpPatternLength - 1;
-                    SERIAL_PRINTLN("Arp:Loop");
-                }
-            } else if (pat == 3) {
-                // Up-Down ping-pong
-                _arpCurrentIndex += _arpDirection;
-                if (_arpCurrentIndex >= _arpPatternLength) {
-                    _arpDirection = -1;
-                    _arpCurrentIndex = max(0, _arpPatternLength - 2);
-                } else if (_arpCurrentIndex < 0) {
-                    _arpDirection = 1;
-                    _arpCurrentIndex = min(1, _arpPatternLength - 1);
-                }
-            } else if (pat == 4 || pat == 5) {
-                // Contract/Expand: iterate through pre-computed buffer, restart on loop
-                if (_arpShufflePos >= _arpPatternLength) {
-                    _arpShufflePos = 0;
-                }
-                _arpCurrentIndex = _arpShuffleBuffer[_arpShufflePos++];
-            } else if (pat == 6) {
-                // Random (shuffle): advance through pre-generated shuffle, re-shuffle on loop
-                if (_arpShufflePos >= _arpPatternLength) {
-                    generateArpShuffle(_arpPatternLength);
-                }
-                _arpCurrentIndex = _arpShuffleBuffer[_arpShufflePos++];
+    // Scheduler stats (pool use, overflows) for the serial diagnostics line
+    const TimingWheel& scheduler() const { return _scheduler; }
+
+    // What the arp plays, step by step (preview, diagnostics)
+    const ArpProgram& arpProgram() const { return _arpProgram; }
+
+private:
+    // One strum cascade in flight
+    struct StrumVoice {
+        bool inProgress = false;         // Cascade still stepping
+        byte key = 0;                    // Key that started it
+        uint8_t generation = 0;          // Bumped on start/stop; stale step/off events are ignored
+        uint32_t startOrder = 0;
+        int notes[MAX_CHORD_NOTES] = {};     // MIDI notes to play in order
+        int velocities[MAX_CHORD_NOTES] = {};
+        int count = 0;                   // Number of notes in this strum
+        int index = 0;                   // Next note to play
+    };
+
+    // Run press/release handling for the keys whose debounced state flipped
+    // (scan-word bits), in key order: chords and the user arp depend on it
+    void handleKeyChanges(uint32_t flipped, unsigned long snapshotUs, unsigned long nowMs) {
+        for (uint32_t edges = _debouncer.edges(); edges; edges &= edges - 1) {
+            _keyEdgeUs[KEY_INDEX.key[__builtin_ctz(edges)]] = snapshotUs;
+        }
+
+        uint32_t changed = 0;
+        for (; flipped; flipped &= flipped - 1) {
+            changed |= 1UL << KEY_INDEX.key[__builtin_ctz(flipped)];
+        }
+        const uint32_t stable = _debouncer.stable();
+
+        for (; changed; changed &= changed - 1) {
+            const int i = __builtin_ctz(changed);
+            if (stable & KEY_MAP[i].mask) {
+                _keyPressStartMs[i] = nowMs;
+                _keyLongPressHandled[i] = false;
+                midiLatency.beginEvent(_keyEdgeUs[i], micros());
+                playMidiNote(KEY_MAP[i].midi, i);  // Pass key index
+                midiLatency.endEvent();
             } else {
-                // Up / chord order (0, 1, 6, 7, default): increment and wrap
-                _arpCurrentIndex++;
-                if (_arpCurrentIndex >= _arpPatternLength) {
-                    _arpCurrentIndex = 0;
-                    SERIAL_PRINTLN("Arp:Loop");
+                bool isLongPressRelease =
+                    _keyPressStartMs[i] > 0 &&
+                    (nowMs - _keyPressStartMs[i]) >= ARP_USER_LATCH_PANIC_HOLD_MS;
+
+                _keyPressStartMs[i] = 0;
+
+                // Release-edge panic: consume release after long hold in USER+LATCH ARP.
+                if (!_keyLongPressHandled[i] && isLongPressRelease &&
+                    _arpUserLatchPanicArmed &&
+                    _arpActive &&
+                    _chordSettings.playMode == PlayMode::ARP &&
+                    _chordSettings.arpUserMode == 1 &&
+                    _chordSettings.arpLatchMode == 1) {
+                    _keyLongPressHandled[i] = true;
+                    SERIAL_PRINTLN("Arp:PanicLP");
+                    stopArpeggiator();
+                } else {
+                    _keyLongPressHandled[i] = false;
+                    stopMidiNote(KEY_MAP[i].midi);
                 }
             }
         }
     }
 
-private:
-    // Fisher-Yates shuffle of indices 0..count-1 into _arpShuffleBuffer
-    void generateArpShuffle(int count) {
-        count = constrain(count, 1, MAX_CHORD_NOTES);
-        for (int i = 0; i < count; i++) _arpShuffleBuffer[i] = i;
-        for (int i = count - 1; i > 0; i--) {
-            int j = random(0, i + 1);
-            int tmp = _arpShuffleBuffer[i];
-            _arpShuffleBuffer[i] = _arpShuffleBuffer[j];
-            _arpShuffleBuffer[j] = tmp;
-        }
-        _arpShufflePos = 0;
-    }
-
-    // Contract (P4): alternate from outer edges inward — low, high, 2nd-low, 2nd-high...
-    void generateArpContract(int count) {
-        count = constrain(count, 1, MAX_CHORD_NOTES);
-        int lo = 0, hi = count - 1, k = 0;
-        while (lo <= hi) {
-            _arpShuffleBuffer[k++] = lo++;
-            if (lo <= hi) _arpShuffleBuffer[k++] = hi--;
-        }
-        _arpShufflePos = 0;
+    // Kinds of event queued on _scheduler
+    enum ScheduledKind : uint8_t {
+        EV_NOTE_OFF,        // Pitch bend overlap / sustain tail (never cancelled)
+        EV_STRUM_NOTE_OFF,  // Tagged with strumTag() of its voice; data is the strum index
+        EV_STRUM_STEP,      // Tagged with strumTag() of its voice
+        EV_ARP_STEP         // Tagged with _arpGeneration
+    };
+
+    // Chord/strum note i of key, tracked in _activeChordHeld so the key
+    // releases exactly the notes it still holds
+    void chordNoteOn(byte key, int i, int velocity) {
+        _activeChordHeld[key] |= 1U << i;
+        _notes.noteOn(_activeChordNotes[key][i], velocity, 1);
     }
 
-    // Expand (P5): from center outward — mid, mid+1, mid-1, mid+2, mid-2...
-    void generateArpExpand(int count) {
-        count = constrain(count, 1, MAX_CHORD_NOTES);
-        int mid = (count - 1) / 2;
-        int k = 0;
-        _arpShuffleBuffer[k++] = mid;
-        for (int d = 1; d < count && k < count; d++) {
-            int hi = mid + d;
-            int lo = mid - d;
-            if (hi < count) _arpShuffleBuffer[k++] = hi;
-            if (lo >= 0 && k < count) _arpShuffleBuffer[k++] = lo;
-        }
-        _arpShufflePos = 0;
+    void chordNoteOff(byte key, int i) {
+        if (!(_activeChordHeld[key] & (1U << i))) return;
+        _activeChordHeld[key] &= ~(1U << i);
+        _notes.noteOff(_activeChordNotes[key][i], 0, 1);
     }
 
-    void schedulePitchBendNoteOff(int note, unsigned long delayUs) {
-        unsigned long due = micros() + delayUs;
-        for (int i = 0; i < MAX_PB_PENDING_OFFS; ++i) {
-            if (!_pbPendingOffActive[i]) {
-                _pbPendingOffNote[i] = note;
-                _pbPendingOffDueUs[i] = due;
-                _pbPendingOffActive[i] = true;
-                return;
+    void releaseChord(byte key, bool log) {
+        for (uint32_t held = _activeChordHeld[key]; held; held &= held - 1) {
+            const int i = __builtin_ctz(held);
+            _notes.noteOff(_activeChordNotes[key][i], 0, 1);
+            if (log) {
+                char buf[16];
+                snprintf(buf, sizeof(buf), "C%d-", _activeChordNotes[key][i]);
+                SERIAL_PRINTLN(buf);
             }
         }
-        // Queue full: fail safe by sending immediate off to avoid stuck notes.
-        _midi.sendNoteOff(note, 0, 1);
+        _activeChordHeld[key] = 0;
+        _activeChordCount[key] = 0;
     }
 
-    void schedulePitchBendNoteOff(int note) {
-        schedulePitchBendNoteOff(note, _pitchBendOverlapUs);
+    // Event tag of a strum voice: pool slot in the low bits, generation above,
+    // so a step or NoteOff finds its voice and is ignored once it restarts
+    uint8_t strumTag(const StrumVoice& voice) const {
+        return (uint8_t)(voice.generation * STRUM_VOICES + (&voice - _strumVoices));
     }
 
-    void processPendingPitchBendNoteOffs() {
-        unsigned long nowUs = micros();
-        for (int i = 0; i < MAX_PB_PENDING_OFFS; ++i) {
-            if (_pbPendingOffActive[i]) {
-                long dt = (long)(nowUs - _pbPendingOffDueUs[i]);
-                if (dt >= 0) {
-                    _midi.sendNoteOff(_pbPendingOffNote[i], 0, 1);
-                    _pbPendingOffActive[i] = false;
-                }
+    // A free voice for key's strum, or the oldest running one, whose cascade
+    // stops (its sounding notes ring on until its key is released)
+    StrumVoice& allocateStrumVoice(byte key) {
+        StrumVoice* voice = nullptr;
+        for (auto& v : _strumVoices) {
+            if (!v.inProgress) {
+                voice = &v;
+                break;
             }
+            if (!voice || (int32_t)(v.startOrder - voice->startOrder) < 0) voice = &v;
         }
+        if (voice->inProgress) {
+            SERIAL_PRINTLN("S:steal");
+            stopStrumVoice(*voice);
+        }
+        voice->inProgress = true;
+        voice->key = key;
+        voice->generation++;
+        voice->startOrder = ++_strumStarts;
+        voice->index = 0;
+        return *voice;
     }
 
-    void scheduleSustainNoteOff(int note, unsigned long delayMs) {
-        if (delayMs == 0) {
-            _midi.sendNoteOff(note, 0, 1);
+    // No note-offs needed - we let notes ring until key release.
+    // Just stop the cascade (pending steps and their NoteOffs go stale).
+    void stopStrumVoice(StrumVoice& voice) {
+        voice.inProgress = false;
+        voice.generation++;
+        voice.index = 0;
+        voice.count = 0;
+    }
+
+    // Strum cascade step: play the voice's next note (scheduled by its previous step)
+    void onStrumStep(StrumVoice& voice, unsigned long dueUs) {
+        if (!voice.inProgress || voice.index >= voice.count) {
+            voice.inProgress = false;  // Strum complete
             return;
         }
-
-        unsigned long due = micros() + (delayMs * 1000UL);
-        for (int i = 0; i < MAX_SUSTAIN_PENDING_OFFS; ++i) {
-            if (!_sustainPendingOffActive[i]) {
-                _sustainPendingOffNote[i] = note;
-                _sustainPendingOffDueUs[i] = due;
-                _sustainPendingOffActive[i] = true;
-                return;
-            }
+        
+        // Play current note
+        chordNoteOn(voice.key, voice.index, voice.velocities[voice.index]);
+        char buf[24];
+        snprintf(buf, sizeof(buf), "S%d:N%dv%d", voice.index, voice.notes[voice.index], voice.velocities[voice.index]);
+        SERIAL_PRINTLN(buf);
+        
+        // Move to next note
+        voice.index++;
+        
+        // Check if strum is complete
+        if (voice.index >= voice.count) {
+            voice.inProgress = false;
+            return;
         }
+        
+        // Hold each note until just before the next strum step so timing feel comes from
+        // swing (onset spacing), not forced staccato note duration.
+        // Steps chain from the due time, not the scan that ran them, so scan jitter doesn't accumulate.
+        unsigned long nextStepUs = dueUs + strumStepDelayMs(voice.index) * 1000UL;
+        if ((long)(nextStepUs - micros()) < 0) nextStepUs = micros();
+        scheduleEvent(nextStepUs - 1000UL, EV_STRUM_NOTE_OFF, voice.index - 1, strumTag(voice), true);
+        scheduleEvent(nextStepUs, EV_STRUM_STEP, 0, strumTag(voice), true);
+    }
 
-        // Queue full: fail safe by sending immediate off to avoid runaways.
-        _midi.sendNoteOff(note, 0, 1);
-        SERIAL_PRINTLN("SustainQ:full");
+    bool scheduleEvent(unsigned long dueUs, ScheduledKind kind, int note, uint8_t tag, bool urgent = false) {
+        const TimingWheel::Event ev = {kind, (uint8_t)note, tag};
+        return _scheduler.schedule(dueUs, ev, urgent);
     }
 
-    void processPendingSustainNoteOffs() {
-        unsigned long nowUs = micros();
-        for (int i = 0; i < MAX_SUSTAIN_PENDING_OFFS; ++i) {
-            if (_sustainPendingOffActive[i]) {
-                long dt = (long)(nowUs - _sustainPendingOffDueUs[i]);
-                if (dt >= 0) {
-                    _midi.sendNoteOff(_sustainPendingOffNote[i], 0, 1);
-                    _sustainPendingOffActive[i] = false;
+    void processScheduledEvents() {
+        _scheduler.advance(micros());
+        TimingWheel::Event ev;
+        unsigned long dueUs;
+        while (_scheduler.pop(ev, dueUs)) {
+            switch (ev.kind) {
+                case EV_NOTE_OFF:
+                    _notes.noteOff(ev.data, 0, 1);
+                    break;
+                case EV_STRUM_NOTE_OFF: {
+                    const StrumVoice& voice = _strumVoices[ev.tag % STRUM_VOICES];
+                    if (ev.tag == strumTag(voice) && voice.inProgress) {
+                        chordNoteOff(voice.key, ev.data);
+                        char buf[16];
+                        snprintf(buf, sizeof(buf), "S%d-off", voice.notes[ev.data]);
+                        SERIAL_PRINTLN(buf);
+                    }
+                    break;
+                }
+                case EV_STRUM_STEP: {
+                    StrumVoice& voice = _strumVoices[ev.tag % STRUM_VOICES];
+                    if (ev.tag == strumTag(voice)) onStrumStep(voice, dueUs);
+                    break;
                 }
+                case EV_ARP_STEP:
+                    if (ev.tag == _arpGeneration) onArpStep(dueUs);
+                    break;
             }
         }
     }
 
-    // Map key index to white key position (-1 if not a white key)
-    // White keys are: SW1-SW12 (indices: 0,1,3,5,6,8,10,12,13,15,17,18)
-    int getWhiteKeyPosition(int keyIndex) const {
-        const int whiteKeyIndices[] = {0, 1, 3, 5, 6, 8, 10, 12, 13, 15, 17, 18};
-        for (int i = 0; i < 12; ++i) {
-            if (whiteKeyIndices[i] == keyIndex) {
-                return i;  // Return position among white keys (0-11)
-            }
+
+    void schedulePitchBendNoteOff(int note, unsigned long delayUs) {
+        if (!scheduleEvent(micros() + delayUs, EV_NOTE_OFF, note, 0)) {
+            // Scheduler full: fail safe by sending immediate off to avoid stuck notes.
+            _notes.noteOff(note, 0, 1);
         }
-        return -1;  // Not a white key
     }
 
-    // In compact mode, black keys repeat the note of their lower (left) adjacent white key.
-    // Hardware key layout (19 keys): white={0,1,3,5,6,8,10,12,13,15,17,18}, black={2,4,7,9,11,14,16}
-    // Maps each black key index to the white-key position (0-based) of the key immediately below it.
-    int getBlackKeyLowerWhitePosition(int keyIndex) const {
-        // black key index -> lower adjacent white key position
-        switch (keyIndex) {
-            case  2: return 1;   // C#/Db -> C (white pos 1)
-            case  4: return 2;   // D#/Eb -> D (white pos 2)
-            case  7: return 4;   // F#/Gb -> F (white pos 4)
-            case  9: return 5;   // G#/Ab -> G (white pos 5)
-            case 11: return 6;   // A#/Bb -> A (white pos 6)
-            case 14: return 8;   // C#/Db (oct2) -> C (white pos 8)
-            case 16: return 9;   // D#/Eb (oct2) -> D (white pos 9)
-            default: return -1;
+    void schedulePitchBendNoteOff(int note) {
+        schedulePitchBendNoteOff(note, _pitchBendOverlapUs);
+    }
+
+    void scheduleSustainNoteOff(int note, unsigned long delayMs) {
+        if (delayMs == 0) {
+            _notes.noteOff(note, 0, 1);
+            return;
+        }
+
+        if (!scheduleEvent(micros() + (delayMs * 1000UL), EV_NOTE_OFF, note, 0)) {
+            // Scheduler full: fail safe by sending immediate off to avoid runaways.
+            _notes.noteOff(note, 0, 1);
+            SERIAL_PRINTLN("Sched:full");
         }
     }
 
@@ -1246,59 +1035,48 @@ private:
         }
     }
 
-    // Expand chord intervals across octaves based on voicing setting
-    void getExpandedIntervals(const int8_t*& intervals, int& count) const {
-        // Get base chord intervals
+    // Chord intervals expanded across octaves by the voicing setting. Cached:
+    // rebuilt only when chordSettingsVersion has moved since the last build,
+    // so repeated chord presses just read it back.
+    void getExpandedIntervals(const int8_t*& intervals, int& count) {
+        const uint32_t version = chordSettingsVersion.load(std::memory_order_acquire);
+        if (!_voicedValid || version != _voicedVersion) {
+            _voicedVersion = version;
+            _voicedValid = true;
+            buildVoicedIntervals();
+        }
+        intervals = _voicedIntervals;
+        count = _voicedCount;
+    }
+
+    // Root-forward voicing: repeat the chord pattern at +12, +24 semitones
+    void buildVoicedIntervals() {
         const int8_t* baseIntervals;
         int baseCount;
         getChordIntervals(baseIntervals, baseCount);
-        
-        // Get voicing multiplier (1-3)
-        int voicing = constrain(_chordSettings.voicing, 1, 3);
-        
-        if (voicing == 1) {
-            // No expansion needed
-            intervals = baseIntervals;
-            count = baseCount;
-            return;
-        }
-        
-        // Expand intervals across octaves
-        static int8_t expandedIntervals[MAX_CHORD_NOTES];
-        int expandedCount = 0;
-        
-        // Build root-forward voicing (repeat chord pattern at +12, +24 semitones)
+        const int voicing = constrain(_chordSettings.voicing, 1, 3);
+
+        _voicedCount = 0;
         for (int octave = 0; octave < voicing; octave++) {
-            int octaveOffset = octave * 12;
-            for (int i = 0; i < baseCount; i++) {
-                if (expandedCount < MAX_CHORD_NOTES) {
-                    expandedIntervals[expandedCount++] = baseIntervals[i] + octaveOffset;
-                }
+            const int octaveOffset = octave * 12;
+            for (int i = 0; i < baseCount && _voicedCount < MAX_CHORD_NOTES; i++) {
+                _voicedIntervals[_voicedCount++] = baseIntervals[i] + octaveOffset;
             }
         }
-        
-        intervals = expandedIntervals;
-        count = expandedCount;
     }
 
     // Calculate velocity for chord note based on velocity spread setting (exponential)
-    int calculateChordVelocity(int noteIndex, int totalNotes) const {
+    int calculateChordVelocity(int noteIndex, int totalNotes) {
         if (_chordSettings.velocitySpread == 0 || noteIndex == 0) {
             // No spread, or root note always gets full velocity
             return _currentVelocity;
         }
-        
-        // Exponential reduction: each subsequent note is a percentage of previous
-        // spreadFactor determines how much each note reduces (0-100% maps to 0-50% reduction per step)
-        float spreadFactor = _chordSettings.velocitySpread / 200.0f; // 0.0 to 0.5
-        float reductionPerStep = 1.0f - spreadFactor; // Multiply by this for each step
-        
-        float velocity = _currentVelocity;
-        for (int i = 0; i < noteIndex; i++) {
-            velocity *= reductionPerStep;
+        if (_chordSettings.velocitySpread != _spreadGainFor) {
+            buildSpreadGains(_chordSettings.velocitySpread);
         }
-        
-        int finalVelocity = (int)velocity;
+        if (noteIndex >= MAX_CHORD_NOTES) noteIndex = MAX_CHORD_NOTES - 1;
+
+        int finalVelocity = (int)(((uint32_t)_currentVelocity * _spreadGainQ16[noteIndex]) >> 16);
         
         // Ensure velocity stays within valid range
         if (finalVelocity < _minVelocity) finalVelocity = _minVelocity;
@@ -1307,7 +1085,21 @@ private:
         return finalVelocity;
     }
 
+    // Gain of each note index under velocity spread, Q16: each note is
+    // (1 - spread/200) of the previous (0-100% maps to 0-50% reduction per
+    // step). Rebuilt only when the spread setting changes.
+    void buildSpreadGains(int spread) {
+        _spreadGainFor = spread;
+        const uint64_t stepQ16 = (((uint64_t)(200 - constrain(spread, 0, 200)) << 16) + 100) / 200;
+        uint64_t gain = 1UL << 16;
+        for (int i = 0; i < MAX_CHORD_NOTES; i++) {
+            _spreadGainQ16[i] = (uint32_t)gain;
+            gain = (gain * stepQ16 + 0x8000) >> 16;
+        }
+    }
+
     MidiTransport& _midi;
+    NoteRefCounter<MidiTransport> _notes;  // Every note goes through here: NoteOn on 0->1, NoteOff on 1->0
     OctaveControlType& _octaveControl;
     ScaleManager& _scaleManager;
     ChordSettings& _chordSettings;
@@ -1316,38 +1108,37 @@ private:
     int _minVelocity;
     bool _isNoteOn[128]{};
     unsigned long _keyPressStartMs[MAX_KEYS]{};
+    unsigned long _keyEdgeUs[MAX_KEYS]{};  // GPIOCache timestamp of the last raw edge (latency stats)
     bool _keyLongPressHandled[MAX_KEYS]{};
-    key _keys[MAX_KEYS];
+    VerticalDebouncer _debouncer{KEY_PRESS_DEBOUNCE_MS, KEY_RELEASE_DEBOUNCE_MS};  // Key pins only
     void (*_velocityChangeHook)(int) = nullptr;
     
     // Chord tracking
     int _activeChordNotes[128][MAX_CHORD_NOTES];  // Store active chord notes for each key
     int _activeChordCount[128];  // Count of active chord notes for each key
+    uint16_t _activeChordHeld[128];  // Bit i: _activeChordNotes[key][i] is on (sent and not yet released)
     
     // Arpeggiator state (for advanced strum mode with pattern > 0)
     bool _arpActive;                    // Is arpeggiator running
     int _arpRootNote;                   // Root note for arpeggio
     const int8_t* _arpPattern;          // Pointer to interval pattern
     int _arpPatternLength;              // Number of intervals in pattern
-    int _arpCurrentIndex;               // Current position in pattern
-    unsigned long _arpLastNoteTime;     // Timestamp of last note
+    uint8_t _arpGeneration;             // Bumped on start/stop; stale step events are ignored
     int _arpCurrentNote;                // Currently playing MIDI note (-1 if none)
-    int _arpDirection;                  // +1 = ascending, -1 = descending (for ping-pong patterns)
-    int _arpLastPattern;                // Tracks pattern changes to reset direction/index
     bool _arpUserLatchPanicArmed;       // Arms long-press panic only after a hands-off moment
-    int _arpShuffleBuffer[MAX_CHORD_NOTES]; // Shuffled index order for random pattern
-    int _arpShufflePos;                 // Current position in shuffle buffer
+    ArpProgram _arpProgram;             // Compiled step cycle; rebuilt when its inputs change
+    int8_t _voicedIntervals[MAX_CHORD_NOTES]; // getExpandedIntervals() cache
+    int _voicedCount = 0;
+    uint32_t _voicedVersion = 0;        // chordSettingsVersion it was built at
+    bool _voicedValid = false;
+    uint32_t _spreadGainQ16[MAX_CHORD_NOTES]; // calculateChordVelocity() table
+    int _spreadGainFor = -1;            // velocitySpread it was built for
     int _pitchBendOffset;               // Semitone offset applied to SCALE mode notes (-2 to +2)
     unsigned long _pitchBendOverlapUs;   // Note overlap window in microseconds (configurable per lever)
     int _baseNote[128];                  // Pre-offset quantized note stored at key press (compact+natural safe)
     bool _sustainActive;                 // True while sustain timing mode is active
     unsigned long _sustainReleaseDelayMs; // Per-release NoteOff tail in ms
-    int _sustainPendingOffNote[MAX_SUSTAIN_PENDING_OFFS];
-    unsigned long _sustainPendingOffDueUs[MAX_SUSTAIN_PENDING_OFFS];
-    bool _sustainPendingOffActive[MAX_SUSTAIN_PENDING_OFFS];
-    int _pbPendingOffNote[MAX_PB_PENDING_OFFS];      // Delayed note-offs for smooth PB overlap
-    unsigned long _pbPendingOffDueUs[MAX_PB_PENDING_OFFS];
-    bool _pbPendingOffActive[MAX_PB_PENDING_OFFS];
+    TimingWheel _scheduler;              // Delayed NoteOffs (PB overlap, sustain tails) and sequencer steps
     
     // Arp USER mode - user-defined note sequence
     int _userArpNotes[8];               // MIDI notes in order pressed (up to 8)
@@ -1357,14 +1148,9 @@ private:
     bool _strumActive;                  // Is a basic strum/chord currently held
     byte _activeStrumKey;               // Which key is currently active
     
-    // Basic strum cascade state (non-blocking playback)
-    bool _strumInProgress;              // Is strum cascade currently playing
-    int _strumNotes[MAX_CHORD_NOTES];   // MIDI notes to play in strum
-    int _strumVelocities[MAX_CHORD_NOTES]; // Velocities for each note
-    unsigned long _strumNoteOffTimes[MAX_CHORD_NOTES]; // Scheduled note-off times for active strum notes
-    int _strumCount;                    // Number of notes in this strum
-    int _strumCurrentIndex;             // Current position in cascade
-    unsigned long _strumLastNoteTime;   // Timestamp of last note played
+    // Basic strum cascades (non-blocking playback), one voice per strum in flight
+    StrumVoice _strumVoices[STRUM_VOICES];
+    uint32_t _strumStarts = 0;          // Voice start counter, for oldest-first stealing
 };
 
 #endif
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <Arduino.h>
 #include <Adafruit_MCP23X17.h>
 
+#include <objects/Globals.h>
 #include <controls/OctaveControl.h>
 #include <controls/KeyboardControl.h>
 #include <objects/Settings.h>
@@ -14,8 +15,8 @@ template<class MidiTransport>
 class LeverControls {
 public:
     LeverControls(
-        Adafruit_MCP23X17* mcpLeft,
-        Adafruit_MCP23X17* mcpRight,
+        ExpanderBank leftBank,
+        ExpanderBank rightBank,
         int leftPin,
         int rightPin,
         LeverSettings& settings,
@@ -27,7 +28,7 @@ public:
         ScaleManager& scaleManager
     );
 
-    void update();
+    void update(const GPIOCache& gpioCache);
     void setFunctionMode(LeverFunctionMode functionMode);
     void setValueMode(ValueMode valueMode);
     void setOnsetTime(unsigned long time);
@@ -44,8 +45,8 @@ public:
 
 private:
     MidiTransport& _midi;
-    Adafruit_MCP23X17* _mcpLeft;
-    Adafruit_MCP23X17* _mcpRight;
+    ExpanderBank _leftBank;
+    ExpanderBank _rightBank;
     int _leftPin;
     int _rightPin;
     LeverSettings& _settings;
@@ -63,14 +64,14 @@ private:
     unsigned long _rampStartTime;
     int _rampStartValue;
 
-    void handleInput();
+    void handleInput(const GPIOCache& gpioCache);
     void updateValue();
 };
 
 template<class MidiTransport>
 LeverControls<MidiTransport>::LeverControls(
-    Adafruit_MCP23X17* mcpLeft,
-    Adafruit_MCP23X17* mcpRight,
+    ExpanderBank leftBank,
+    ExpanderBank rightBank,
     int leftPin,
     int rightPin,
     LeverSettings& settings,
@@ -82,8 +83,8 @@ LeverControls<MidiTransport>::LeverControls(
     ScaleManager& scaleManager)
     :
     _midi(midi),
-    _mcpLeft(mcpLeft),
-    _mcpRight(mcpRight),
+    _leftBank(leftBank),
+    _rightBank(rightBank),
     _leftPin(leftPin),
     _rightPin(rightPin),
     _settings(settings),
@@ -130,12 +131,12 @@ LeverControls<MidiTransport>::LeverControls(
     }
 
 template<class MidiTransport>
-void LeverControls<MidiTransport>::update() {
+void LeverControls<MidiTransport>::update(const GPIOCache& gpioCache) {
     // Skip lever processing during cooldown (after BLE toggle)
     if (millis() < leverCooldownUntil) {
         return;
     }
-    handleInput();
+    handleInput(gpioCache);
     updateValue();
 }
 
@@ -243,9 +244,10 @@ void LeverControls<MidiTransport>::syncValue() {
 }
 
 template<class MidiTransport>
-void LeverControls<MidiTransport>::handleInput() {
-    bool leftState = !_mcpLeft->digitalRead(_leftPin);
-    bool rightState = !_mcpRight->digitalRead(_rightPin);
+void LeverControls<MidiTransport>::handleInput(const GPIOCache& gpioCache) {
+    // Switch states from this scan's bulk read (no I2C here)
+    bool leftState = gpioCache.isPinLow(_leftBank, _leftPin);
+    bool rightState = gpioCache.isPinLow(_rightBank, _rightPin);
     int oldTargetValue = _targetValue;
 
     if (_settings.functionMode == LeverFunctionMode::INCREMENTAL) {
@@ -283,7 +285,7 @@ void LeverControls<MidiTransport>::handleInput() {
             if (leftState && !_isPressed) {
                 int currentChord = (int)_chordSettings.chordType;
                 currentChord = max(0, currentChord - 1);
-                _chordSettings.chordType = (ChordType)currentChord;
+                setChordShape(_chordSettings.chordType, (ChordType)currentChord);
                 _currentValue = map(currentChord, 0, 14, _settings.minCCValue, _settings.maxCCValue);
                 _lastSentValue = _currentValue;
                 _isPressed = true;
@@ -294,7 +296,7 @@ void LeverControls<MidiTransport>::handleInput() {
             } else if (rightState && !_isPressed) {
                 int currentChord = (int)_chordSettings.chordType;
                 currentChord = min(14, currentChord + 1);
-                _chordSettings.chordType = (ChordType)currentChord;
+                setChordShape(_chordSettings.chordType, (ChordType)currentChord);
                 _currentValue = map(currentChord, 0, 14, _settings.minCCValue, _settings.maxCCValue);
                 _lastSentValue = _currentValue;
                 _isPressed = true;
@@ -431,24 +433,10 @@ void LeverControls<MidiTransport>::updateValue() {
         if (rampDuration == 0 || elapsedTime >= rampDuration) {
             _currentValue = _targetValue;
         } else {
-            float progress = (float)elapsedTime / (float)rampDuration;
-
-            if (_isPressed) {
-                if (_settings.onsetType == InterpolationType::EXPONENTIAL) {
-                    progress = pow(progress, 2);
-                } else if (_settings.onsetType == InterpolationType::LOGARITHMIC) {
-                    progress = 1 - pow(1 - progress, 2);
-                }
-            } else {
-                if (_settings.offsetType == InterpolationType::EXPONENTIAL) {
-                    progress = pow(progress, 2);
-                } else if (_settings.offsetType == InterpolationType::LOGARITHMIC) {
-                    progress = 1 - pow(1 - progress, 2);
-                }
-            }
-
-            float totalValueChange = _targetValue - _rampStartValue;
-            _currentValue = _rampStartValue + (int)(progress * totalValueChange);
+            const InterpolationType shape = _isPressed ? _settings.onsetType : _settings.offsetType;
+            const int32_t progress = rampProgressQ16(shape, elapsedTime, rampDuration);
+            const int32_t totalValueChange = _targetValue - _rampStartValue;
+            _currentValue = _rampStartValue + (int)(totalValueChange * progress / 65536);  // Truncates toward zero
         }
     }
 
@@ -529,7 +517,7 @@ void LeverControls<MidiTransport>::updateValue() {
             } else {
                 // Map CC value (0-127) to pattern range (1-6)
                 int pattern = map(sendVal, _settings.minCCValue, _settings.maxCCValue, 1, 6);
-                _chordSettings.strumPattern = constrain(pattern, 1, 6);
+                setChordShape(_chordSettings.strumPattern, constrain(pattern, 1, 6));
                 SERIAL_PRINT("P"); SERIAL_PRINTLN(_chordSettings.strumPattern);
             }
         } else if (_settings.ccNumber == 202) {
@@ -570,7 +558,7 @@ void LeverControls<MidiTransport>::updateValue() {
             // Map user's CC range to chord type 0-14
             int chordIndex = map(sendVal, _settings.minCCValue, _settings.maxCCValue, 0, 14);
             chordIndex = constrain(chordIndex, 0, 14);
-            _chordSettings.chordType = (ChordType)chordIndex;
+            setChordShape(_chordSettings.chordType, (ChordType)chordIndex);
             SERIAL_PRINT("ChordType="); SERIAL_PRINTLN(chordIndex);
             // Notify BLE clients of the change
             if (notifyChordSettingsCallback) {
@@ -14,7 +14,7 @@ template<class MidiTransport>
 class LeverPushControls {
 public:
     LeverPushControls(
-        Adafruit_MCP23X17* mcp,
+        ExpanderBank bank,
         int centerPin,
         LeverPushSettings& settings,
         LeverControls<MidiTransport>& leverControls,
@@ -26,7 +26,7 @@ public:
         ScaleManager& scaleManager
     );
 
-    void update();
+    void update(const GPIOCache& gpioCache);
     void setCCNumber(int number);
     void setMinCCValue(int number);
     void setMaxCCValue(int number);
@@ -38,7 +38,7 @@ public:
     void syncValue(); // Re-sync internal value when settings change
 
 private:
-    Adafruit_MCP23X17* _mcp;
+    ExpanderBank _bank;
     int _centerPin;
     LeverPushSettings& _settings;
     LeverControls<MidiTransport>& _leverControls;
@@ -58,13 +58,13 @@ private:
     int _rampStartValue;
     int _previousCCNumber;
 
-    void handleInput();
+    void handleInput(const GPIOCache& gpioCache);
     void updateValue();
 };
 
 template<class MidiTransport>
 LeverPushControls<MidiTransport>::LeverPushControls(
-    Adafruit_MCP23X17* mcp,
+    ExpanderBank bank,
     int centerPin,
     LeverPushSettings& settings,
     LeverControls<MidiTransport>& leverControls,
@@ -75,7 +75,7 @@ LeverPushControls<MidiTransport>::LeverPushControls(
     ChordSettings& chordSettings,
     ScaleManager& scaleManager)
     :
-    _mcp(mcp),
+    _bank(bank),
     _centerPin(centerPin),
     _settings(settings),
     _leverControls(leverControls),
@@ -97,8 +97,8 @@ LeverPushControls<MidiTransport>::LeverPushControls(
     }
 
 template<class MidiTransport>
-void LeverPushControls<MidiTransport>::update() {
-    handleInput();
+void LeverPushControls<MidiTransport>::update(const GPIOCache& gpioCache) {
+    handleInput(gpioCache);
     updateValue();
 }
 
@@ -172,7 +172,7 @@ void LeverPushControls<MidiTransport>::syncValue() {
 }
 
 template<class MidiTransport>
-void LeverPushControls<MidiTransport>::handleInput() {
+void LeverPushControls<MidiTransport>::handleInput(const GPIOCache& gpioCache) {
     // Reset pattern state if CC changed away from Pattern Selector (201)
     if (_previousCCNumber == 201 && _settings.ccNumber != 201) {
         _lastSentValue = _settings.minCCValue;
@@ -193,7 +193,7 @@ void LeverPushControls<MidiTransport>::handleInput() {
         return;
     }
 
-    bool state = !_mcp->digitalRead(_centerPin);
+    bool state = gpioCache.isPinLow(_bank, _centerPin);  // From this scan's bulk read
     int oldTargetValue = _targetValue;
 
     if (_settings.functionMode == LeverPushFunctionMode::RESET) {
@@ -240,7 +240,7 @@ void LeverPushControls<MidiTransport>::handleInput() {
                 
                 // Set discrete MIDI value for the pattern and update shared state
                 _currentValue = patternMidi[currentPattern - 1];
-                _chordSettings.strumPattern = currentPattern;
+                setChordShape(_chordSettings.strumPattern, currentPattern);
                 _isPressed = true;
                 
                 SERIAL_PRINT("P");
@@ -304,7 +304,7 @@ void LeverPushControls<MidiTransport>::handleInput() {
                     if (currentVoicing < 1) currentVoicing = 3;
                 }
                 
-                _chordSettings.voicing = currentVoicing;
+                setChordShape(_chordSettings.voicing, currentVoicing);
                 _currentValue = map(currentVoicing, 1, 3, _settings.minCCValue, _settings.maxCCValue);
                 _lastSentValue = _currentValue; // Prevent send() from remapping
                 _isPressed = true;
@@ -431,24 +431,10 @@ void LeverPushControls<MidiTransport>::updateValue() {
         if (rampDuration == 0 || elapsedTime >= rampDuration) {
             _currentValue = _targetValue;
         } else {
-            float progress = (float)elapsedTime / (float)rampDuration;
-
-            if (_isPressed) {
-                if (_settings.onsetType == InterpolationType::EXPONENTIAL) {
-                    progress = pow(progress, 2);
-                } else if (_settings.onsetType == InterpolationType::LOGARITHMIC) {
-                    progress = 1 - pow(1 - progress, 2);
-                }
-            } else {
-                if (_settings.offsetType == InterpolationType::EXPONENTIAL) {
-                    progress = pow(progress, 2);
-                } else if (_settings.offsetType == InterpolationType::LOGARITHMIC) {
-                    progress = 1 - pow(1 - progress, 2);
-                }
-            }
-
-            float totalValueChange = _targetValue - _rampStartValue;
-            _currentValue = _rampStartValue + (int)(progress * totalValueChange);
+            const InterpolationType shape = _isPressed ? _settings.onsetType : _settings.offsetType;
+            const int32_t progress = rampProgressQ16(shape, elapsedTime, rampDuration);
+            const int32_t totalValueChange = _targetValue - _rampStartValue;
+            _currentValue = _rampStartValue + (int)(totalValueChange * progress / 65536);  // Truncates toward zero
         }
     }
 
@@ -510,7 +496,7 @@ void LeverPushControls<MidiTransport>::updateValue() {
                 }
                 lastPattern = pattern;
                 
-                _chordSettings.strumPattern = constrain(pattern, 1, 6);
+                setChordShape(_chordSettings.strumPattern, constrain(pattern, 1, 6));
                 SERIAL_PRINT("P"); SERIAL_PRINTLN(_chordSettings.strumPattern);
                 
                 // Notify BLE clients of the change
@@ -553,7 +539,7 @@ void LeverPushControls<MidiTransport>::updateValue() {
             // 205 = KB1 Expression: Note Range (voicing 1-3)
             int voicing = map(sendVal, _settings.minCCValue, _settings.maxCCValue, 1, 3);
             voicing = constrain(voicing, 1, 3);
-            _chordSettings.voicing = voicing;
+            setChordShape(_chordSettings.voicing, voicing);
             SERIAL_PRINT("NoteRange="); SERIAL_PRINTLN(voicing);
             // Notify BLE clients of the change
             if (notifyChordSettingsCallback) {
@@ -49,6 +49,11 @@ public:
         return currentOctave;
     }
 
+    // S3/S4 button pins on U2 (for interrupt-on-change setup)
+    static constexpr uint16_t buttonPinMask() {
+        return (1 << S3_PIN) | (1 << S4_PIN);
+    }
+
 private:
     void shiftOctave(int shift) {
         currentOctave += shift;
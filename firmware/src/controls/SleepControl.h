@@ -18,6 +18,8 @@
 
 // Forward-declare touch wake callback implemented in main.cpp
 extern void IRAM_ATTR touchWakeCallback();
+// Touch baseline kept in RTC memory across deep sleep (0 = none), main.cpp
+extern int32_t touchBaselineRtc;
 
 // Forward declaration so enterLightSleep can call enterDeepSleep below
 template<typename TouchT, typename KeyboardT>
@@ -86,8 +88,9 @@ inline void enterLightSleep(TouchT &touch,
     const uint32_t blueOnMs = 150UL;
 
     const uint8_t wakePin = T1;
-    const uint32_t cfgThresh = touchSettings.threshold;
-    uint32_t wakeCalc = cfgThresh / 2;
+    // Relative to the untouched level, so baseline drift cannot make the
+    // pad unreachable or hair-trigger
+    const uint32_t wakeCalc = touch.wakeThreshold();
     const uint16_t wakeThreshold = (wakeCalc > 0x7FFF) ? 0x7FFF : (uint16_t)wakeCalc;
 
     uint32_t startMs = millis();
@@ -185,8 +188,7 @@ inline void enterDeepSleep(TouchT &touch,
     const uint32_t uptimeMs = millis();
     const uint32_t idleMs = (uptimeMs > lastActivityMillis) ? (uptimeMs - lastActivityMillis) : 0;
     const uint8_t wakePin = T1;
-    const uint32_t cfgThresh = touchSettings.threshold;
-    uint32_t wakeCalc = cfgThresh / 2;
+    const uint32_t wakeCalc = touch.wakeThreshold();
     const uint16_t wakeThreshold = (wakeCalc > 0x7FFF) ? 0x7FFF : (uint16_t)wakeCalc;
     const uint32_t freeHeap = ESP.getFreeHeap();
 
@@ -195,6 +197,7 @@ inline void enterDeepSleep(TouchT &touch,
     SERIAL_PRINT("Idle before sleep (ms): "); SERIAL_PRINTLN(idleMs);
     SERIAL_PRINT("Touch wake pin: "); SERIAL_PRINTLN(wakePin);
     SERIAL_PRINT("Touch wake threshold: "); SERIAL_PRINTLN(wakeThreshold);
+    SERIAL_PRINT("Touch baseline: "); SERIAL_PRINTLN(touch.baseline());
     SERIAL_PRINT("Free heap (bytes): "); SERIAL_PRINTLN(freeHeap);
     SERIAL_PRINTLN("-------------------------");
 
@@ -203,6 +206,9 @@ inline void enterDeepSleep(TouchT &touch,
 
     sleepBlinkOnce<TouchT, KeyboardT>(ledController, PINK_PWM_MAX, PWM_MAX);
 
+    // A waking touch must not become the baseline on the next boot
+    touchBaselineRtc = touch.baseline();
+
     SERIAL_PRINTLN("Entering deep sleep now.");
     delay(50);
     esp_deep_sleep_start();
@@ -18,7 +18,8 @@ public:
         MidiTransport& midi,
         ChordSettings& chordSettings,
         LEDController& ledController,
-        ScaleManager& scaleManager
+        ScaleManager& scaleManager,
+        const SystemSettings& systemSettings
     ) :
         _touchPin(touchPin),
         _settings(settings),
@@ -28,18 +29,59 @@ public:
         _chordSettings(chordSettings),
         _ledController(ledController),
         _scaleManager(scaleManager),
+        _systemSettings(systemSettings),
         _lastCCTouchValue(-1),
         _lastTouchToggle(0),
         _touchDebounceTime(250),      // 250ms for Hold/Continuous (EMI rejection)
-        _toggleDebounceTime(50),       // 50ms for Toggle mode (5× faster pattern selection)
+        _toggleDebounceTime(30),       // 30ms for Toggle mode (baseline-relative thresholds keep it clean)
         _toggleState(false),
         _wasPressed(false),
-        _smoothedValue(0.0f),
-        _smoothingAlpha(.075f),
-        _previousCCNumber(-1)
+        _previousCCNumber(-1),
+        _filtered(0),
+        _filterPrimed(false),
+        _baseline(0),
+        _baselinePrimed(false),
+        _previousMode(settings.functionMode),
+        _pressure(0),
+        _lastPressureSent(0),
+        _lastPressureSentMs(0),
+        _lastPressureUpdateMs(0)
     {}
 
-    void update() {
+    // Latest raw measurement of the touch pad (called by the input scanner).
+    // The touch FSM measures continuously in the background (see
+    // setupTouchSensing in main.cpp), so this reads a register, no wait.
+    int sample() const {
+        return touchRead(_touchPin);
+    }
+
+    // Filtered pad value in raw sensor units
+    int filteredValue() const {
+        return (int)((_filtered + (1 << (IIR_SHIFT - 1))) >> IIR_SHIFT);
+    }
+
+    // Untouched pad level in raw sensor units. Tracked in the background:
+    // falls quickly, rises slowly, frozen while the pad is engaged.
+    int baseline() const {
+        return (int)((_baseline + (1 << (IIR_SHIFT - 1))) >> IIR_SHIFT);
+    }
+
+    // Start from a known baseline (e.g. kept in RTC memory across deep
+    // sleep) instead of the first sample, which may be a waking touch
+    void seedBaseline(int raw) {
+        _baseline = (int32_t)raw << IIR_SHIFT;
+        _baselinePrimed = true;
+    }
+
+    // Touch distance above the baseline for the hardware wake/edge interrupt:
+    // half the configured on-threshold
+    uint32_t wakeThreshold() const {
+        const int delta = (_settings.threshold - _sensorMin) / 2;
+        return delta > 0 ? (uint32_t)delta : 1;
+    }
+
+    // Feed one raw reading from sample() through smoothing and the function mode
+    void update(int raw) {
         // Reset pattern state if CC changed away from Pattern Selector (201)
         if (_previousCCNumber == 201 && _settings.ccNumber != 201) {
             _lastCCTouchValue = -1;
@@ -49,38 +91,54 @@ public:
         }
         _previousCCNumber = _settings.ccNumber;
 
+        // Leaving AFTERTOUCH: don't leave the receiver holding a pressure
+        if (_previousMode == TouchFunctionMode::AFTERTOUCH && _settings.functionMode != TouchFunctionMode::AFTERTOUCH &&
+            _lastPressureSent != 0) {
+            _midi.sendAfterTouch(0, 1);
+            _lastPressureSent = 0;
+            _pressure = 0;
+        }
+        _previousMode = _settings.functionMode;
+
         // Disable Pattern Selector (201) when not in ARP mode
         // Disable Swing (202) when not in ARP mode
         // Disable Latch (207) when not in ARP mode
+        // (AFTERTOUCH ignores ccNumber)
         bool isArpMode = (_chordSettings.playMode == PlayMode::ARP);
-        if (_settings.ccNumber == 201 && !isArpMode) {
+        bool usesCC = (_settings.functionMode != TouchFunctionMode::AFTERTOUCH);
+        if (usesCC && _settings.ccNumber == 201 && !isArpMode) {
             return;
         }
-        if (_settings.ccNumber == 202 && !isArpMode) {
+        if (usesCC && _settings.ccNumber == 202 && !isArpMode) {
             return;
         }
-        if (_settings.ccNumber == 207 && !isArpMode) {
+        if (usesCC && _settings.ccNumber == 207 && !isArpMode) {
             return;
         }
 
-        int raw = touchRead(_touchPin);
-
-        // Initialize smoothed value on first run
-        if (_smoothedValue == 0.0f) {
-            _smoothedValue = (float)raw;
+        // Initialize the filter on first run
+        if (!_filterPrimed) {
+            _filtered = (int32_t)raw << IIR_SHIFT;
+            _filterPrimed = true;
         }
 
-        // Exponential moving average smoothing
-        // Use lighter smoothing for Toggle mode to enable rapid re-triggering
-        float smoothingAlpha = (_settings.functionMode == TouchFunctionMode::TOGGLE) ? 0.3f : _smoothingAlpha;
-        _smoothedValue = (smoothingAlpha * (float)raw) + ((1.0f - smoothingAlpha) * _smoothedValue);
-        int touchValue = (int)(_smoothedValue + 0.5f);
+        // Integer IIR (exponential moving average) in Q8
+        // Use lighter smoothing for Toggle mode to enable rapid re-triggering,
+        // and for Aftertouch, where dead-band and slew take over the smoothing
+        const bool lightSmoothing = (_settings.functionMode == TouchFunctionMode::TOGGLE ||
+                                     _settings.functionMode == TouchFunctionMode::AFTERTOUCH);
+        const int32_t alpha = lightSmoothing ? IIR_ALPHA_TOGGLE : IIR_ALPHA;
+        _filtered += ((((int32_t)raw << IIR_SHIFT) - _filtered) * alpha) >> IIR_SHIFT;
+        if (!_baselinePrimed) {
+            seedBaseline(raw);
+        }
+        int touchValue = relativeValue();
 
-        // Hysteresis thresholds: on = settings.threshold, off = 75% of threshold (but not below sensor min)
-        // For Toggle mode, use tighter hysteresis (50%) to allow faster release detection
+        // Hysteresis thresholds, relative to the baseline: on = settings.threshold,
+        // off = halfway back down to the untouched level
         int onThreshold = _settings.threshold;
-        float offRatio = (_settings.functionMode == TouchFunctionMode::TOGGLE) ? 0.5f : 0.75f;
-        int offThreshold = max(_sensorMin, (int)(_settings.threshold * offRatio));
+        int offThreshold = releaseThreshold();
+        trackBaseline(touchValue > offThreshold || _toggleState || _wasPressed);
 
         switch (_settings.functionMode) {
             case TouchFunctionMode::HOLD: {
@@ -125,7 +183,7 @@ public:
                                 // 205 = KB1 Expression: Note Range / voicing (1-3 octave spread)
                                 int voicing = map(sendVal, _settings.minCCValue, _settings.maxCCValue, 1, 3);
                                 voicing = constrain(voicing, 1, 3);
-                                _chordSettings.voicing = voicing;
+                                setChordShape(_chordSettings.voicing, voicing);
                                 SERIAL_PRINT("NoteRange="); SERIAL_PRINTLN(voicing);
                                 if (notifyChordSettingsCallback) {
                                     notifyChordSettingsCallback();
@@ -158,11 +216,11 @@ public:
                         if (isPressed && !_wasPressed) {
                             // Special handling for Pattern Selector (CC 201): cycle through patterns
                             if (_settings.ccNumber == 201) {
-                                // Rate limiting with adaptive debounce: 50ms for Toggle mode (5× faster than previous 250ms)
+                                // Rate limiting with adaptive debounce: 30ms for Toggle mode
                                 // Allows rapid pattern cycling while preventing bounce
                                 static unsigned long lastPatternChange = 0;
                                 unsigned long now = millis();
-                                if (now - lastPatternChange < _toggleDebounceTime) {  // Use 50ms for Toggle mode
+                                if (now - lastPatternChange < _toggleDebounceTime) {  // Use 30ms for Toggle mode
                                     _wasPressed = isPressed;  // Update state to prevent re-trigger
                                     break;
                                 }
@@ -207,7 +265,7 @@ public:
                                 _lastCCTouchValue = sendVal;
                                 
                                 // Update internal chord settings to match the pattern change
-                                _chordSettings.strumPattern = constrain(currentPattern, 1, 6);
+                                setChordShape(_chordSettings.strumPattern, constrain(currentPattern, 1, 6));
                                 
                                 // Notify BLE clients of the change
                                 if (notifyChordSettingsCallback) {
@@ -291,7 +349,7 @@ public:
                                 _ledController.set(isForward ? LedColor::BLUE : LedColor::PINK, 0);
                                 _ledController.set(isForward ? LedColor::PINK : LedColor::BLUE, 0, 300);
 
-                                _chordSettings.voicing = currentVoicing;
+                                setChordShape(_chordSettings.voicing, currentVoicing);
 
                                 // Send MIDI CC (map voicing back to MIDI range)
                                 int sendVal205 = map(currentVoicing, 1, 3, _settings.minCCValue, _settings.maxCCValue);
@@ -409,7 +467,7 @@ public:
                                     // 205 = KB1 Expression: Note Range / voicing (1-3 octave spread)
                                     int voicing = map(sendVal, _settings.minCCValue, _settings.maxCCValue, 1, 3);
                                     voicing = constrain(voicing, 1, 3);
-                                    _chordSettings.voicing = voicing;
+                                    setChordShape(_chordSettings.voicing, voicing);
                                     SERIAL_PRINT("NoteRange="); SERIAL_PRINTLN(voicing);
                                     if (notifyChordSettingsCallback) {
                                         notifyChordSettingsCallback();
@@ -428,23 +486,24 @@ public:
                                 }
                             }
                         }
-                        // Update _wasPressed: true if smoothed value is above offThreshold
+                        // Update _wasPressed: true if the relative value is above offThreshold
                         _wasPressed = (touchValue > offThreshold);
                 break;
             }
             case TouchFunctionMode::CONTINUOUS: {
                         // Use smoothed reading for continuous mapping to reduce jitter
                         int clampedSensorValue = max(_sensorMin, min(_sensorMax, touchValue));
-                        float percentage = 0.0f;
+                        int span = 0;
                         if (_sensorMax != _sensorMin) {
-                            percentage = (float)(clampedSensorValue - _sensorMin) / (float)(_sensorMax - _sensorMin);
+                            span = (clampedSensorValue - _sensorMin) * (_settings.maxCCValue - _settings.minCCValue) /
+                                   (_sensorMax - _sensorMin);
                         }
                         // REV mode (offsetTime > 0): invert mapping — release returns to maxCC instead of minCC
                         int ccValue;
                         if (_settings.offsetTime > 0) {
-                            ccValue = _settings.maxCCValue - (int)(percentage * (_settings.maxCCValue - _settings.minCCValue));
+                            ccValue = _settings.maxCCValue - span;
                         } else {
-                            ccValue = _settings.minCCValue + (int)(percentage * (_settings.maxCCValue - _settings.minCCValue));
+                            ccValue = _settings.minCCValue + span;
                         }
 
                         if (_lastCCTouchValue != ccValue) {
@@ -478,7 +537,7 @@ public:
                                 // 205 = KB1 Expression: Note Range / voicing (1-3 octave spread)
                                 int voicing = map(sendVal, 0, 127, 1, 3);
                                 voicing = constrain(voicing, 1, 3);
-                                _chordSettings.voicing = voicing;
+                                setChordShape(_chordSettings.voicing, voicing);
                                 SERIAL_PRINT("NoteRange="); SERIAL_PRINTLN(voicing);
                                 if (notifyChordSettingsCallback) {
                                     notifyChordSettingsCallback();
@@ -507,19 +566,33 @@ public:
                         }
                 break;
             }
+            case TouchFunctionMode::AFTERTOUCH: {
+                        // Pressure over minCC..maxCC while engaged, 0 once released
+                        int target = 0;
+                        if (touchValue > offThreshold) {
+                            int clampedSensorValue = max(_sensorMin, min(_sensorMax, touchValue));
+                            target = _settings.minCCValue;
+                            if (_sensorMax != _sensorMin) {
+                                target += (clampedSensorValue - _sensorMin) * (_settings.maxCCValue - _settings.minCCValue) /
+                                          (_sensorMax - _sensorMin);
+                            }
+                        }
+                        updatePressure(constrain(target, 0, 127));
+                break;
+            }
             default:
                 break;
         }
     }
 
     // Returns whether the touch sensor is currently considered "active".
-    // Call this after `update()` so `_smoothedValue` and state are up-to-date.
+    // Call this after `update()` so the filter and state are up-to-date.
     bool isActive() {
-        int touchValue = (int)(_smoothedValue + 0.5f);
-        int onThreshold = _settings.threshold;
-        int offThreshold = max(_sensorMin, (int)(_settings.threshold * 0.75f));
+        int touchValue = relativeValue();
+        int offThreshold = releaseThreshold();
         switch (_settings.functionMode) {
             case TouchFunctionMode::CONTINUOUS:
+            case TouchFunctionMode::AFTERTOUCH:
                 return touchValue > offThreshold;
             case TouchFunctionMode::HOLD:
             case TouchFunctionMode::TOGGLE:
@@ -529,6 +602,67 @@ public:
     }
 
 private:
+    // IIR weights in Q8: 19/256 ~ 0.075 (5ms samples), 77/256 ~ 0.3 for Toggle/Aftertouch
+    static constexpr int IIR_SHIFT = 8;
+    static constexpr int32_t IIR_ALPHA = 19;
+    static constexpr int32_t IIR_ALPHA_TOGGLE = 77;
+    // Baseline tracking per sample: ~20s time constant upwards, ~0.3s down
+    // (a reading below the baseline cannot be a touch)
+    static constexpr int BASELINE_RISE_SHIFT = 12;
+    static constexpr int BASELINE_FALL_SHIFT = 6;
+    // Longest gap between samples the pressure slew honours (after idle)
+    static constexpr unsigned long PRESSURE_MAX_DT_MS = 100;
+
+    // Filtered value with baseline drift removed, in the settings' units
+    // (the untouched pad reads _sensorMin)
+    int relativeValue() const {
+        return filteredValue() - baseline() + _sensorMin;
+    }
+
+    int releaseThreshold() const {
+        return _sensorMin + max(0, _settings.threshold - _sensorMin) / 2;
+    }
+
+    // AFTERTOUCH output: slew-limit the pressure toward target, then send it
+    // through the MIDI output's continuous lane (coalesced like a CC) when it
+    // moved past the dead-band and the rate limit allows. Release to 0 always
+    // goes out, so the receiver never keeps a stale pressure.
+    void updatePressure(int target) {
+        const unsigned long now = millis();
+        unsigned long dt = now - _lastPressureUpdateMs;
+        _lastPressureUpdateMs = now;
+        if (dt > PRESSURE_MAX_DT_MS) dt = PRESSURE_MAX_DT_MS;
+
+        const int32_t targetQ8 = (int32_t)target << IIR_SHIFT;
+        const int slew = _systemSettings.touchPressureSlew;
+        if (slew > 0) {
+            const int32_t maxStep = max((int32_t)1, (int32_t)((long)slew * (long)dt * (1 << IIR_SHIFT) / 1000));
+            _pressure += constrain(targetQ8 - _pressure, -maxStep, maxStep);
+        } else {
+            _pressure = targetQ8;
+        }
+
+        const int value = (int)((_pressure + (1 << (IIR_SHIFT - 1))) >> IIR_SHIFT);
+        if (value == _lastPressureSent) return;
+        const bool released = (value == 0);
+        if (!released && abs(value - _lastPressureSent) <= max(_systemSettings.touchPressureDeadBand, 0)) return;
+        const int rateHz = _systemSettings.touchPressureRateHz;
+        if (rateHz > 0 && now - _lastPressureSentMs < 1000UL / (unsigned long)rateHz) return;
+
+        _midi.sendAfterTouch(value, 1);
+        _lastPressureSent = value;
+        _lastPressureSentMs = now;
+    }
+
+    void trackBaseline(bool engaged) {
+        const int32_t error = _filtered - _baseline;
+        if (error < 0) {
+            _baseline += error >> BASELINE_FALL_SHIFT;
+        } else if (!engaged) {
+            _baseline += error >> BASELINE_RISE_SHIFT;
+        }
+    }
+
     int _touchPin;
     TouchSettings& _settings;
     int _sensorMin;
@@ -538,17 +672,26 @@ private:
     ChordSettings& _chordSettings;
     LEDController& _ledController;
     ScaleManager& _scaleManager;
+    const SystemSettings& _systemSettings;
 
     int _lastCCTouchValue;
     unsigned long _lastTouchToggle;
     unsigned long _touchDebounceTime;     // Debounce for Hold/Continuous modes (250ms)
-    unsigned long _toggleDebounceTime;    // Debounce for Toggle mode (50ms, faster re-trigger)
+    unsigned long _toggleDebounceTime;    // Debounce for Toggle mode (30ms, faster re-trigger)
     bool _toggleState;
     bool _wasPressed;
     int _previousCCNumber;
-    // Smoothing state
-    float _smoothedValue;
-    float _smoothingAlpha;
+    // Smoothing and baseline state (raw << IIR_SHIFT)
+    int32_t _filtered;
+    bool _filterPrimed;
+    int32_t _baseline;
+    bool _baselinePrimed;
+    // AFTERTOUCH state
+    TouchFunctionMode _previousMode;
+    int32_t _pressure;                   // Slewed pressure (value << IIR_SHIFT)
+    int _lastPressureSent;
+    unsigned long _lastPressureSentMs;
+    unsigned long _lastPressureUpdateMs;
 };
 
 #endif
\ No newline at end of file
@@ -9,7 +9,8 @@ float lerp(float a, float b, float f) {
 LEDController::LEDController() {
     // Initialize LED states
     pinkLed.pin = -1;
-    pinkLed.mcp = nullptr;
+    pinkLed.bus = nullptr;
+    pinkLed.expanderLevel = -1;
     pinkLed.mode = LedMode::STATIC;
     pinkLed.currentBrightness = 0;
     pinkLed.targetBrightness = 0;
@@ -19,7 +20,8 @@ LEDController::LEDController() {
     pinkLed.pulseDuration = 0;
 
     blueLed.pin = -1;
-    blueLed.mcp = nullptr;
+    blueLed.bus = nullptr;
+    blueLed.expanderLevel = -1;
     blueLed.mode = LedMode::STATIC;
     blueLed.currentBrightness = 0;
     blueLed.targetBrightness = 0;
@@ -29,7 +31,8 @@ LEDController::LEDController() {
     blueLed.pulseDuration = 0;
 
     octaveUpLed.pin = -1;
-    octaveUpLed.mcp = nullptr;
+    octaveUpLed.bus = nullptr;
+    octaveUpLed.expanderLevel = -1;
     octaveUpLed.mode = LedMode::STATIC;
     octaveUpLed.currentBrightness = 0;
     octaveUpLed.targetBrightness = 0;
@@ -39,7 +42,8 @@ LEDController::LEDController() {
     octaveUpLed.pulseDuration = 0;
 
     octaveDownLed.pin = -1;
-    octaveDownLed.mcp = nullptr;
+    octaveDownLed.bus = nullptr;
+    octaveDownLed.expanderLevel = -1;
     octaveDownLed.mode = LedMode::STATIC;
     octaveDownLed.currentBrightness = 0;
     octaveDownLed.targetBrightness = 0;
@@ -60,7 +64,7 @@ LEDController::~LEDController() {
 }
 
 
-void LEDController::begin(LedColor color, int pin, Adafruit_MCP23X17* mcp) {
+void LEDController::begin(LedColor color, int pin, ExpanderBus* bus, ExpanderBank bank) {
     if (_mutex) xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
     LedState* led = nullptr;
     switch (color) {
@@ -80,10 +84,11 @@ void LEDController::begin(LedColor color, int pin, Adafruit_MCP23X17* mcp) {
 
     if (led) {
         led->pin = pin;
-        led->mcp = mcp;
-        if (mcp) {
-            mcp->pinMode(pin, OUTPUT);
-            mcp->digitalWrite(pin, HIGH);
+        led->bus = bus;
+        led->bank = bank;
+        if (bus) {
+            bus->configureOutput(bank, pin, HIGH);
+            led->expanderLevel = HIGH;
         } else {
             pinMode(led->pin, OUTPUT);
             analogWrite(led->pin, led->currentBrightness);
@@ -118,8 +123,8 @@ void LEDController::set(LedColor color, int targetBrightness, unsigned long dura
         led->duration = duration;
         if (duration == 0) {
             led->currentBrightness = led->targetBrightness;
-            if (led->mcp) {
-                led->mcp->digitalWrite(led->pin, led->currentBrightness > 0 ? LOW : HIGH);
+            if (led->bus) {
+                writeExpander(*led, led->currentBrightness > 0 ? LOW : HIGH);
             } else {
                 analogWrite(led->pin, led->currentBrightness);
             }
@@ -164,6 +169,14 @@ void LEDController::update() {
     if (_mutex) xSemaphoreGiveRecursive(_mutex);
 }
 
+// Expander LEDs are on/off: post only when the level actually changes, so
+// update() every millisecond leaves the bus idle while nothing changes
+void LEDController::writeExpander(LedState& led, int level) {
+    if (led.expanderLevel == level) return;
+    led.expanderLevel = (int8_t)level;
+    led.bus->post(led.bank, led.pin, level != LOW);
+}
+
 void LEDController::updateLed(LedState& led) {
     if (led.pin == -1) {
         // LED not initialized
@@ -173,11 +186,11 @@ void LEDController::updateLed(LedState& led) {
     unsigned long currentTime = millis();
     unsigned long elapsedTime = currentTime - led.startTime;
 
-    if (led.mcp) { // MCP-controlled LED (digital, active-low)
+    if (led.bus) { // MCP-controlled LED (digital, active-low)
         if (led.mode == LedMode::STATIC) {
             if (elapsedTime >= led.duration) {
                 led.currentBrightness = led.targetBrightness;
-                led.mcp->digitalWrite(led.pin, led.currentBrightness > 0 ? LOW : HIGH);
+                writeExpander(led, led.currentBrightness > 0 ? LOW : HIGH);
             } else {
                 // No interpolation for MCP, just wait until duration ends
             }
@@ -186,8 +199,8 @@ void LEDController::updateLed(LedState& led) {
                 // Stop pulsing after total duration
                 led.mode = LedMode::STATIC;
                 led.currentBrightness = 0;
-                if (led.mcp) {
-                    led.mcp->digitalWrite(led.pin, HIGH); // Turn off for active-low
+                if (led.bus) {
+                    writeExpander(led, HIGH); // Turn off for active-low
                 } else {
                     analogWrite(led.pin, 0);
                 }
@@ -195,7 +208,7 @@ void LEDController::updateLed(LedState& led) {
             }
             float progress = (float)(elapsedTime % led.pulseDuration) / (float)led.pulseDuration;
             int state = progress < 0.5f ? LOW : HIGH; // 50% duty cycle
-            led.mcp->digitalWrite(led.pin, state);
+            writeExpander(led, state);
             led.currentBrightness = (state == LOW) ? 255 : 0;
         }
     } else { // GPIO-controlled LED (analog)
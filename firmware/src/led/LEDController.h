@@ -2,8 +2,8 @@
 #define LED_CONTROLLER_H
 
 #include <Arduino.h>
-#include <Adafruit_MCP23X17.h>
 #include <freertos/semphr.h>
+#include <objects/ExpanderBus.h>
 
 enum class LedColor {
     PINK,
@@ -21,7 +21,9 @@ class LEDController {
 public:
     LEDController();
     ~LEDController();
-    void begin(LedColor color, int pin, Adafruit_MCP23X17* mcp = nullptr);
+    // With bus: an active-low LED on an expander pin, driven through the bus
+    // owner; otherwise a PWM pin
+    void begin(LedColor color, int pin, ExpanderBus* bus = nullptr, ExpanderBank bank = BANK_U2);
     void set(LedColor color, int targetBrightness, unsigned long duration = 0);
     void pulse(LedColor color, unsigned long pulseSpeed, unsigned long totalPulsationDuration = 0);
     void update();
@@ -29,7 +31,9 @@ public:
 private:
     struct LedState {
         int pin;
-        Adafruit_MCP23X17* mcp;
+        ExpanderBus* bus;
+        ExpanderBank bank;
+        int8_t expanderLevel;  // Last level posted to the bus (-1 = none)
         LedMode mode;
         int currentBrightness;
         int targetBrightness;
@@ -47,6 +51,7 @@ private:
     SemaphoreHandle_t _mutex = NULL;
 
     static void updateLed(LedState& led);
+    static void writeExpander(LedState& led, int level);
 };
 
 #endif
@@ -21,17 +21,24 @@
 #include <BLEDevice.h>
 #include <esp_bt_main.h>
 #include <esp_sleep.h>
+#include <esp_timer.h>
 #include <esp_system.h>
 #include <driver/gpio.h>
+#include <driver/touch_sensor.h>
 #include <soc/usb_serial_jtag_reg.h>
 #include <soc/usb_serial_jtag_struct.h>
 #include <bt/BluetoothController.h>
 #include <objects/Constants.h>
 #include <objects/Globals.h>
+#include <objects/SpscRing.h>
+#include <objects/ExpanderBus.h>
+#include <objects/ScanRateScheduler.h>
 #include <objects/Settings.h>
 #include <led/LEDController.h>
 #include <music/ScaleManager.h>
 #include <music/StrumPatterns.h>
+#include <midi/MidiLatency.h>
+#include <midi/MidiOutput.h>
 #include <controls/KeyboardControl.h>
 #include <controls/LeverControls.h>
 #include <controls/TouchControl.h>
@@ -42,6 +49,8 @@
 
 Adafruit_MCP23X17 mcp_U1;
 Adafruit_MCP23X17 mcp_U2;
+// Only readInputs talks to the expanders once the tasks run (see ExpanderBus)
+ExpanderBus expanderBus(mcp_U1, mcp_U2);
 
 // Global flag for serial connection detection
 #ifdef SERIAL_PRINT_ENABLED
@@ -57,6 +66,8 @@ CustomPattern customPattern = {
     .length = 8
 };
 
+std::atomic<uint32_t> chordSettingsVersion{0};
+
 // Lever cooldown after BLE toggle (prevents MIDI output during lever release)
 unsigned long leverCooldownUntil = 0;
 
@@ -74,9 +85,34 @@ void (*notifyScaleSettingsCallback)() = nullptr;
 
 // Callback for resetting pattern controls when shape mode is disabled
 void (*resetPatternControlsCallback)() = nullptr;
-
-// I2C mutex for thread-safe access to MCP23017 chips
-static SemaphoreHandle_t i2cMutex = NULL;
+static volatile bool patternResetPending = false;  // Set by BLE task, consumed by musicEngineTask
+
+// Music engine mutex: keyboardControl, the controls that drive it and the
+// send side of midiOut are shared by musicEngineTask and seqClockTask
+static SemaphoreHandle_t engineMutex = NULL;
+
+// Scanner -> engine hand-off: readInputs only reads the hardware and pushes
+// timestamped InputEvents; musicEngineTask pops them and runs everything else
+// (controls, keyboard, MIDI, LED targets, sleep), so a slow UART or BLE stall
+// in the engine never delays a scan
+static constexpr size_t INPUT_EVENT_RING_SIZE = 32;  // ~160ms of scans with every pin changing
+static SpscRing<InputEvent, INPUT_EVENT_RING_SIZE> inputEvents;
+static std::atomic<uint32_t> inputEventDrops{0};
+static TaskHandle_t musicEngineTaskHandle = NULL;
+static volatile bool inputScanPaused = false;  // Light-sleep loop owns the hardware
+
+// Scan period chosen by readInputs from recent activity. inputsActive is set
+// by musicEngineTask while keys, levers, touch or the arp are in use.
+static ScanRateScheduler scanRate;
+static volatile bool inputsActive = false;
+
+// Sequencer clock: one-shot esp_timer armed for the next scheduled event
+// (arp/strum step, NoteOff tail), waking seqClockTask at that exact time
+static esp_timer_handle_t seqClockTimer = NULL;
+static TaskHandle_t seqClockTaskHandle = NULL;
+static unsigned long seqClockArmedUs = 0;
+static bool seqClockArmed = false;
+static constexpr long SEQ_CLOCK_MIN_US = 20;  // Floor for already-due events
 
 // LED command queue to serialize all access to ledController from one task
 typedef struct {
@@ -121,11 +157,9 @@ void ledTask(void *pvParameters) {
                 ledController.set((LedColor)cmd.color, cmd.value, cmd.dur);
             }
         }
-        // Always call update from this task (with I2C mutex protection)
-        if (xSemaphoreTake(i2cMutex, portMAX_DELAY) == pdTRUE) {
-            ledController.update();
-            xSemaphoreGive(i2cMutex);
-        }
+        // Always call update from this task; expander LEDs only post to
+        // expanderBus, readInputs writes them
+        ledController.update();
         vTaskDelay(1 / portTICK_PERIOD_MS);
     }
 }
@@ -153,6 +187,13 @@ const unsigned long BLUE_RAMP_DOWN_MS = 150;
 
 MIDI_CREATE_INSTANCE(HardwareSerial, Serial0, MIDI);
 
+// Scan -> MIDI latency histograms (fed by KeyboardControl and midiOut)
+MidiLatencyStats midiLatency;
+
+// All control MIDI output goes through this stage: queued bytes are handed to the
+// Serial0 TX buffer without blocking (wire-time model + latency stats)
+MidiOutput<HardwareSerial> midiOut(Serial0);
+
 //----------------------------------
 // Octave Control Setup
 //----------------------------------
@@ -191,8 +232,8 @@ ChordSettings chordSettings = {
 //----------------------------------
 // KeyboardControl Setup
 //----------------------------------
-KeyboardControl<decltype(MIDI), decltype(octaveControl)> keyboardControl(
-    MIDI,
+KeyboardControl<decltype(midiOut), decltype(octaveControl)> keyboardControl(
+    midiOut,
     octaveControl,
     scaleManager,
     chordSettings
@@ -213,13 +254,13 @@ LeverSettings lever1Settings = {
     .onsetType = InterpolationType::LINEAR,
     .offsetType = InterpolationType::LINEAR,
 };
-LeverControls<decltype(MIDI)> lever1(
-    &mcp_U1,
-    &mcp_U2,
+LeverControls<decltype(midiOut)> lever1(
+    BANK_U1,
+    BANK_U2,
     SWD1_LEFT_PIN,
     SWD1_RIGHT_PIN,
     lever1Settings,
-    MIDI,
+    midiOut,
     ledController,
     LedColor::PINK,
     keyboardControl,
@@ -240,12 +281,12 @@ LeverPushSettings leverPush1Settings = {
     .onsetType = InterpolationType::LOGARITHMIC,
     .offsetType = InterpolationType::LOGARITHMIC,
 };
-LeverPushControls<decltype(MIDI)> leverPush1(
-    &mcp_U1,
+LeverPushControls<decltype(midiOut)> leverPush1(
+    BANK_U1,
     SWD1_CENTER_PIN,
     leverPush1Settings,
     lever1,
-    MIDI,
+    midiOut,
     ledController,
     LedColor::PINK,
     keyboardControl,
@@ -268,13 +309,13 @@ LeverSettings lever2Settings = {
     .onsetType = InterpolationType::LINEAR,
     .offsetType = InterpolationType::LINEAR,
 };
-LeverControls<decltype(MIDI)> lever2(
-    &mcp_U2,
-    &mcp_U2,
+LeverControls<decltype(midiOut)> lever2(
+    BANK_U2,
+    BANK_U2,
     SWD2_LEFT_PIN,
     SWD2_RIGHT_PIN,
     lever2Settings,
-    MIDI,
+    midiOut,
     ledController,
     LedColor::BLUE,
     keyboardControl,
@@ -295,12 +336,12 @@ LeverPushSettings leverPush2Settings = {
     .onsetType = InterpolationType::LINEAR,
     .offsetType = InterpolationType::LINEAR,
 };
-LeverPushControls<decltype(MIDI)> leverPush2(
-        &mcp_U2,
+LeverPushControls<decltype(midiOut)> leverPush2(
+        BANK_U2,
         SWD2_CENTER_PIN,
         leverPush2Settings,
         lever2,
-        MIDI,
+        midiOut,
         ledController,
         LedColor::BLUE,
         keyboardControl,
@@ -308,6 +349,17 @@ LeverPushControls<decltype(MIDI)> leverPush2(
         scaleManager
 );
 
+SystemSettings systemSettings = {
+    .lightSleepTimeout = 300,   // 5 minutes
+    .deepSleepTimeout = 120,    // 2 minutes
+    .bleTimeout = 600,          // 10 minutes
+    .idleConfirmTimeout = 2,    // 2 seconds
+    .scanLatencyBudgetMs = INPUT_SCAN_IDLE_MS,
+    .touchPressureRateHz = 100,    // 2-3 bytes each: ~8% of the DIN link at most
+    .touchPressureDeadBand = 1,    // Ignore +-1 sensor jitter
+    .touchPressureSlew = 2540,     // Full range in 50ms
+};
+
 //----------------------------------
 // Touch Sensor Setup
 //----------------------------------
@@ -319,24 +371,18 @@ TouchSettings touchSettings = {
     .threshold = 36800,  // 20% (range: 30000-64000 maps to 0-100%)
     .offsetTime = 100,  // REV mode (release returns to max)
 };
-TouchControl<decltype(MIDI)> touch(
+TouchControl<decltype(midiOut)> touch(
     T1,
     touchSettings,
     30000,
     64000,
-    MIDI,
+    midiOut,
     chordSettings,
     ledController,
-    scaleManager
+    scaleManager,
+    systemSettings
 );
 
-SystemSettings systemSettings = {
-    .lightSleepTimeout = 300,   // 5 minutes
-    .deepSleepTimeout = 120,    // 2 minutes
-    .bleTimeout = 600,          // 10 minutes
-    .idleConfirmTimeout = 2,    // 2 seconds
-};
-
 Preferences preferences;
 BluetoothController* bluetoothControllerPtr = nullptr;
 
@@ -396,27 +442,101 @@ void IRAM_ATTR touchWakeCallback() {
     // empty: waking is handled by hardware wake source
 }
 
+RTC_DATA_ATTR int32_t touchBaselineRtc = 0;
+
+static TaskHandle_t readInputsTaskHandle = NULL;
+
+// Touch threshold interrupt (pad crossed the wake hint either way): sample
+// the pad now instead of at the next scan
+static volatile bool touchEdgePending = false;
+
+void IRAM_ATTR touchEdgeISR() {
+    touchEdgePending = true;
+    BaseType_t woken = pdFALSE;
+    if (readInputsTaskHandle) {
+        vTaskNotifyGiveFromISR(readInputsTaskHandle, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// Arm the threshold interrupt halfway between the untouched level (the
+// peripheral's benchmark) and the configured on-threshold. It is only a hint
+// to sample early; TouchControl's hysteresis still decides on/off. The sleep
+// code attaches its own wake callback, so this is re-run after light sleep.
+static void attachTouchEdgeInterrupt() {
+    touchAttachInterrupt(T1, touchEdgeISR, touch.wakeThreshold());
+}
+
+// Touch pad measured continuously by the touch FSM (timer mode, started by
+// the core on the first touchRead), so TouchControl::sample() only reads the
+// latest result. The peripheral's IIR filter maintains the benchmark the
+// threshold interrupt compares against.
+static void setupTouchSensing() {
+    touchRead(T1);
+    touch_filter_config_t filter = {};
+    filter.mode = TOUCH_PAD_FILTER_IIR_16;
+    filter.debounce_cnt = 1;
+    filter.noise_thr = 0;
+    filter.jitter_step = 4;
+    filter.smh_lvl = TOUCH_PAD_SMOOTH_IIR_2;
+    touch_pad_filter_set_config(&filter);
+    touch_pad_filter_enable();
+    attachTouchEdgeInterrupt();
+
+    // After a deep-sleep wake the first sample is likely the waking touch
+    if (esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_UNDEFINED && touchBaselineRtc > 0) {
+        touch.seedBaseline(touchBaselineRtc);
+        SERIAL_PRINT("Touch baseline restored: "); SERIAL_PRINTLN(touchBaselineRtc);
+    }
+}
+
+#if MCP_INT_PIN >= 0
+// MCP23017 interrupt-on-change (INTA/INTB): wake readInputs to scan now.
+// The bulk GPIO read in readInputs clears the expanders' interrupt.
+void IRAM_ATTR mcpInterruptISR() {
+    BaseType_t woken = pdFALSE;
+    if (readInputsTaskHandle) {
+        vTaskNotifyGiveFromISR(readInputsTaskHandle, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// Enable interrupt-on-change on every input pin (keys, levers, pushes,
+// octave buttons), INTA/INTB mirrored and open-drain so both expanders can
+// share one active-low line
+static void setupExpanderInterrupts() {
+    const uint16_t u1Inputs = keyboardControl.keyPinMask(BANK_U1) |
+                              (1 << SWD1_LEFT_PIN) | (1 << SWD1_CENTER_PIN);
+    const uint16_t u2Inputs = keyboardControl.keyPinMask(BANK_U2) |
+                              (1 << SWD1_RIGHT_PIN) | (1 << SWD2_LEFT_PIN) | (1 << SWD2_CENTER_PIN) |
+                              (1 << SWD2_RIGHT_PIN) | octaveControl.buttonPinMask();
+    mcp_U1.setupInterrupts(true, true, LOW);
+    mcp_U2.setupInterrupts(true, true, LOW);
+    for (uint8_t pin = 0; pin < 16; pin++) {
+        if (u1Inputs & (1 << pin)) mcp_U1.setupInterruptPin(pin, CHANGE);
+        if (u2Inputs & (1 << pin)) mcp_U2.setupInterruptPin(pin, CHANGE);
+    }
+    mcp_U1.readGPIOAB();  // Clear anything latched during setup
+    mcp_U2.readGPIOAB();
+    pinMode(MCP_INT_PIN, INPUT_PULLUP);
+    attachInterrupt(digitalPinToInterrupt(MCP_INT_PIN), mcpInterruptISR, FALLING);
+    SERIAL_PRINTLN("Inputs: MCP interrupt-driven scanning");
+}
+#endif
+
 void readInputs(void *pvParameters);
+void musicEngineTask(void *pvParameters);
+void seqClockTask(void *pvParameters);
+static void seqClockTimerCallback(void *arg);
 
 // Bulk read all GPIO pins from both MCP chips in just 2 I2C transactions
 // Optimized I2C performance: 25+ individual reads → 2 bulk reads
 // Performance: ~12× faster (5-6ms → ~0.4ms), 92% I2C bus reduction
 // Power: -8-12mA savings during active use
 // Returns cached pin states for efficient extraction via bitwise operations
+// Bus owner (readInputs) only
 GPIOCache readAllGPIO() {
-    GPIOCache cache;
-    if (xSemaphoreTake(i2cMutex, portMAX_DELAY) == pdTRUE) {
-        cache.u1_pins = mcp_U1.readGPIOAB();  // Read all 16 pins from U1 (1 transaction)
-        cache.u2_pins = mcp_U2.readGPIOAB();  // Read all 16 pins from U2 (1 transaction)
-        cache.timestamp = micros();            // High-precision timestamp
-        xSemaphoreGive(i2cMutex);
-    } else {
-        // Mutex timeout (shouldn't happen, but be defensive)
-        cache.u1_pins = 0xFFFF;  // All pins HIGH (released/not pressed)
-        cache.u2_pins = 0xFFFF;
-        cache.timestamp = micros();
-    }
-    return cache;
+    return expanderBus.read();
 }
 
 // USB Power Detection (uses USB peripheral, not Serial CDC)
@@ -951,6 +1071,7 @@ void loadSettings() {
     preferences.getBytes("scale", &scaleSettings, sizeof(ScaleSettings));
     preferences.getBytes("chord", &chordSettings, sizeof(ChordSettings));
     preferences.getBytes("customStrum", &customPattern, sizeof(CustomPattern));
+    chordSettingsChanged();
     preferences.getBytes("system", &systemSettings, sizeof(SystemSettings));
 
     scaleManager.setScale(scaleSettings.scaleType);
@@ -1164,18 +1285,12 @@ void setup() {
     mcp_U2.pinMode(SWD2_CENTER_PIN, INPUT_PULLUP);
     mcp_U2.pinMode(SWD2_RIGHT_PIN, INPUT_PULLUP);
 
-    // Create I2C mutex for thread-safe access to MCP23017 chips
-    i2cMutex = xSemaphoreCreateMutex();
-    if (i2cMutex == NULL) {
-        SERIAL_PRINTLN("Error creating I2C mutex");
-        while (true) {}
-    }
-
-    // Create I/O input reading task on Core 1 (Protocol CPU)
-    // Touch sensor requires Core 1 access (hardware peripheral affinity)
-    // Priority 2 (higher than LED task) for minimal input latency
-    xTaskCreatePinnedToCore(readInputs, "readInputs", 4096, nullptr, 2, nullptr, 1);
+    // Expander LEDs are configured here, before readInputs owns the bus
+    ledController.begin(LedColor::OCTAVE_UP, 7, &expanderBus, BANK_U2);
+    ledController.begin(LedColor::OCTAVE_DOWN, 5, &expanderBus, BANK_U2);
 
+    // TX buffer must be sized before MIDI.begin() opens the UART
+    Serial0.setTxBufferSize(MIDI_UART_TX_BUFFER);
     MIDI.begin(1);
 
     // MIDI panic on boot: clear any garbage state caused by UART TX floating during
@@ -1183,9 +1298,10 @@ void setup() {
     // This auto-recovers connected synths without needing a manual patch reload.
     delay(100);  // Let UART settle before sending
     for (int ch = 1; ch <= 16; ch++) {
-        MIDI.sendControlChange(121, 0, ch);  // Reset All Controllers
-        MIDI.sendControlChange(123, 0, ch);  // All Notes Off
+        midiOut.sendControlChange(121, 0, ch);  // Reset All Controllers
+        midiOut.sendControlChange(123, 0, ch);  // All Notes Off
     }
+    midiOut.flush();  // Nothing else may touch midiOut until musicEngineTask owns it
     keyboardControl.begin();
 
     // Register velocity hook to keep lever2 in sync when velocity changes
@@ -1194,8 +1310,43 @@ void setup() {
     };
     keyboardControl.registerVelocityChangeHook(velocityHook);
 
-    ledController.begin(LedColor::OCTAVE_UP, 7, &mcp_U2);
-    ledController.begin(LedColor::OCTAVE_DOWN, 5, &mcp_U2);
+    setupTouchSensing();
+#if MCP_INT_PIN >= 0
+    setupExpanderInterrupts();
+#endif
+
+    engineMutex = xSemaphoreCreateMutex();
+    if (engineMutex == NULL) {
+        SERIAL_PRINTLN("Error creating engine mutex");
+        while (true) {}
+    }
+
+    // Sequencer clock task on Core 1, above musicEngineTask so a due step
+    // preempts the engine instead of waiting for its next pass
+    xTaskCreatePinnedToCore(seqClockTask, "seqClock", 4096, nullptr, 3, &seqClockTaskHandle, 1);
+    const esp_timer_create_args_t seqClockArgs = {
+        .callback = &seqClockTimerCallback,
+        .arg = nullptr,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "seqClock",
+    };
+    if (esp_timer_create(&seqClockArgs, &seqClockTimer) != ESP_OK) {
+        seqClockTimer = NULL;  // Steps still fire from musicEngineTask, at scan resolution
+        SERIAL_PRINTLN("Warning: sequencer clock timer unavailable");
+    }
+
+    // Music engine task on Core 1, priority 2 (above the LED task)
+    // Started after the boot panic: with seqClockTask it is the only sender on midiOut
+    xTaskCreatePinnedToCore(musicEngineTask, "musicEngine", 4096, nullptr, 2, &musicEngineTaskHandle, 1);
+
+    // Create I/O input reading task on Core 1 (Protocol CPU)
+    // Touch sensor requires Core 1 access (hardware peripheral affinity)
+    // Priority 4, above everything else on Core 1: it only reads and stamps
+    // the hardware (blocking in the I2C driver, not the CPU), so it never
+    // waits behind MIDI or engine work
+    xTaskCreatePinnedToCore(readInputs, "readInputs", 3072, nullptr, 4, &readInputsTaskHandle, 1);
+    // An LED change wakes the owner so it is written now, not after an idle scan
+    expanderBus.setOwnerWake([] { xTaskNotifyGive(readInputsTaskHandle); });
 
     ledController.begin(LedColor::BLUE, BLUE_LED_PWM_PIN);
     ledController.begin(LedColor::PINK, PINK_LED_PWM_PIN);
@@ -1208,8 +1359,8 @@ void setup() {
         SERIAL_PRINTLN("Warning: failed to create LED queue");
     }
     // Create LED update task on Core 1 (same as inputs)
-    // CRITICAL: I2C devices (MCP23017 LEDs) require same core to avoid mutex race conditions
-    // Moving to Core 0 causes "Unfinished Repeated Start transaction!" assertion failures
+    // It no longer touches I2C (expander LEDs go through expanderBus); sharing
+    // the bus from Core 0 used to cause "Unfinished Repeated Start transaction!"
     xTaskCreatePinnedToCore(ledTask, "ledTask", 4096, nullptr, 1, nullptr, 1);
 
     // Run LED startup sequence
@@ -1252,12 +1403,9 @@ void setup() {
     };
 
     // Set up callback to stop arpeggiator when shape mode is disabled
+    // Runs on the BLE task, so only flag it; musicEngineTask sends the NoteOff
     resetPatternControlsCallback = []() {
-        // If shape mode is disabled (strumPattern = 0), stop the arpeggiator
-        if (chordSettings.strumPattern == 0) {
-            keyboardControl.stopArpeggiator();
-            SERIAL_PRINTLN("Arpeggiator stopped - shape mode disabled");
-        }
+        patternResetPending = true;
     };
 
     // Initialize BLE gesture control (cross-lever activation)
@@ -1450,6 +1598,83 @@ void loop() {
     }
     #endif
     
+    // Scan -> MIDI latency summary (every 30s, only when new key events were measured)
+    #ifdef SERIAL_PRINT_ENABLED
+    static unsigned long lastLatencyPrint = 0;
+    static uint32_t lastLatencyEvents = 0;
+    if (serialConnected && millis() - lastLatencyPrint > 30000) {
+        if (midiLatency.events() != lastLatencyEvents) {
+            char buf[128];
+            midiLatency.format(buf, sizeof(buf));
+            SERIAL_PRINTLN(buf);
+            lastLatencyEvents = midiLatency.events();
+        }
+        // MIDI TX counters: dropped (ring full), lost CC updates (back-pressure),
+        // merged CCs (same tick), CCs parked for a slot, running-status hits
+        static uint32_t lastDropped = 0;
+        static uint32_t lastLost = 0;
+        static uint32_t lastMerged = 0;
+        static uint32_t lastParked = 0;
+        if (midiOut.droppedMessages() != lastDropped || midiOut.lostUpdates() != lastLost ||
+            midiOut.coalescedMessages() != lastMerged || midiOut.parkedControls() != lastParked) {
+            lastDropped = midiOut.droppedMessages();
+            lastLost = midiOut.lostUpdates();
+            lastMerged = midiOut.coalescedMessages();
+            lastParked = midiOut.parkedControls();
+            char buf[96];
+            snprintf(buf, sizeof(buf), "MidiTx drop%lu lost%lu merge%lu park%lu rs%lu", (unsigned long)lastDropped,
+                     (unsigned long)lastLost, (unsigned long)lastMerged, (unsigned long)lastParked,
+                     (unsigned long)midiOut.runningStatusHits());
+            SERIAL_PRINTLN(buf);
+        }
+        // Keyboard event scheduler: pool use (now/peak), overflows, clamped long tails
+        static uint32_t lastScheduled = 0;
+        if (keyboardControl.scheduler().scheduled() != lastScheduled) {
+            lastScheduled = keyboardControl.scheduler().scheduled();
+            char buf[64];
+            keyboardControl.scheduler().format(buf, sizeof(buf));
+            SERIAL_PRINTLN(buf);
+        }
+        // Scanner -> engine ring: events dropped because the engine fell behind
+        static uint32_t lastInputDrops = 0;
+        if (inputEventDrops.load() != lastInputDrops) {
+            lastInputDrops = inputEventDrops.load();
+            char buf[48];
+            snprintf(buf, sizeof(buf), "InEv drop%lu", (unsigned long)lastInputDrops);
+            SERIAL_PRINTLN(buf);
+        }
+        // Expander latch writes (LED changes); flat while the LEDs hold still
+        static uint32_t lastBusWrites = 0;
+        if (expanderBus.writes() != lastBusWrites) {
+            lastBusWrites = expanderBus.writes();
+            char buf[32];
+            snprintf(buf, sizeof(buf), "Bus w%lu", (unsigned long)lastBusWrites);
+            SERIAL_PRINTLN(buf);
+        }
+        // Note reference counts: NoteOns absorbed by a note already sounding,
+        // NoteOffs for notes nothing held
+        static uint32_t lastMergedOns = 0, lastStrayOffs = 0;
+        {
+            const auto& notes = keyboardControl.notes();
+            if (notes.mergedOns() != lastMergedOns || notes.strayOffs() != lastStrayOffs) {
+                lastMergedOns = notes.mergedOns();
+                lastStrayOffs = notes.strayOffs();
+                char buf[48];
+                snprintf(buf, sizeof(buf), "Notes on%u merged%lu stray%lu", notes.soundingCount(),
+                         (unsigned long)lastMergedOns, (unsigned long)lastStrayOffs);
+                SERIAL_PRINTLN(buf);
+            }
+        }
+        // Input scan rate: current period and share of time at each rate
+        {
+            char buf[96];
+            scanRate.format(buf, sizeof(buf));
+            SERIAL_PRINTLN(buf);
+        }
+        lastLatencyPrint = millis();
+    }
+    #endif
+
     // Periodically print CPU usage stats (every 10 seconds)
     // NOTE: Disabled due to linker issues with vTaskGetRunTimeStats on ESP32-S3
     // #ifdef SERIAL_PRINT_ENABLED
@@ -1555,13 +1780,181 @@ void loop() {
     }
     vTaskDelay(1 / portTICK_PERIOD_MS);
 }
+
+static void seqClockTimerCallback(void *arg) {
+    (void)arg;
+    xTaskNotifyGive(seqClockTaskHandle);
+}
+
+// (Re)arm the sequencer clock for the next scheduled event. Caller holds engineMutex.
+static void armSequencerClock() {
+    unsigned long dueUs;
+    if (!seqClockTimer || !keyboardControl.nextEventDueUs(dueUs)) return;
+    if (seqClockArmed && dueUs == seqClockArmedUs) return;
+    long aheadUs = (long)(dueUs - micros());
+    if (aheadUs < SEQ_CLOCK_MIN_US) aheadUs = SEQ_CLOCK_MIN_US;
+    esp_timer_stop(seqClockTimer);  // ESP_ERR_INVALID_STATE if idle, harmless
+    esp_timer_start_once(seqClockTimer, (uint64_t)aheadUs);
+    seqClockArmedUs = dueUs;
+    seqClockArmed = true;
+}
+
+// Fires arp/strum steps and NoteOff tails at their due time instead of on the
+// next 5ms scan. Sleeps until the timer callback notifies it.
+[[noreturn]] void seqClockTask(void *pvParameters) {
+    (void)pvParameters;
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        if (xSemaphoreTake(engineMutex, portMAX_DELAY) == pdTRUE) {
+            seqClockArmed = false;
+            keyboardControl.runScheduler();
+            armSequencerClock();
+            xSemaphoreGive(engineMutex);
+        }
+    }
+}
+
+static bool pushInputEvent(const InputEvent& ev) {
+    if (!inputEvents.push(ev)) {
+        inputEventDrops++;
+        return false;
+    }
+    return true;
+}
+
+// Scanner: the only reader of the input hardware and the I2C bus owner.
+// Samples the touch pad and both expanders, stamps each reading and queues
+// it for musicEngineTask, then writes posted expander outputs (LEDs).
+// GPIO snapshots go out only when a pin changed; one that did not fit is
+// retried every scan, since the engine must always end up with the latest.
+// The scan period adapts to activity (scanRate); touch is sampled at most
+// every TOUCH_SAMPLE_MS so burst scans do not speed up its per-sample smoothing.
 [[noreturn]] void readInputs(void *pvParameters) {
+    (void)pvParameters;
+    GPIOCache lastSent = {0xFFFF, 0xFFFF, 0};
+    bool gpioPending = true;  // First snapshot always goes out
+    unsigned long lastTouchUs = micros() - TOUCH_SAMPLE_MS * 1000UL;
     while (true) {
-        touch.update();
-        
+        if (inputScanPaused) {
+            expanderBus.flush();  // The sleep sequence still drives the octave LEDs
+            vTaskDelay(INPUT_SCAN_IDLE_MS / portTICK_PERIOD_MS);
+            continue;
+        }
+
+        bool pushed = false;
+        // Half a ms of slack so tick jitter never skips a touch sample; a
+        // threshold edge samples at once
+        const bool touchEdge = touchEdgePending;
+        if (touchEdge || micros() - lastTouchUs >= TOUCH_SAMPLE_MS * 1000UL - 500) {
+            touchEdgePending = false;
+            lastTouchUs = micros();
+            const InputEvent touchSample = {InputEvent::TOUCH_SAMPLE, 0, 0, (uint32_t)touch.sample(), lastTouchUs};
+            pushed |= pushInputEvent(touchSample);
+        }
+
         // BULK READ: Get all 32 GPIO pins in just 2 I2C transactions (12× faster than 25+ individual reads)
-        GPIOCache gpioCache = readAllGPIO();
-        
+        const GPIOCache gpioCache = readAllGPIO();
+        const bool gpioChanged = (gpioCache.u1_pins ^ lastSent.u1_pins) | (gpioCache.u2_pins ^ lastSent.u2_pins);
+        if (gpioPending || gpioChanged) {
+            const InputEvent snapshot = {InputEvent::GPIO_SNAPSHOT, gpioCache.u1_pins, gpioCache.u2_pins, 0,
+                                         gpioCache.timestamp};
+            gpioPending = !pushInputEvent(snapshot);
+            pushed |= !gpioPending;
+            lastSent = gpioCache;
+        }
+        if (pushed) xTaskNotifyGive(musicEngineTaskHandle);
+        expanderBus.flush();
+
+        // Scan period: 1ms burst after an edge (trills, bounce), 5ms while
+        // playing, 20ms idle, never above the configured latency budget
+        const unsigned long nowMs = millis();
+        if (gpioChanged) scanRate.onEdge(nowMs);
+        if (inputsActive || touchEdge) scanRate.onActivity(nowMs);
+        scanRate.setLatencyBudgetMs(systemSettings.scanLatencyBudgetMs);
+        const unsigned long periodMs = scanRate.nextPeriodMs(nowMs);
+        // A touch edge (or a pin change, with MCP_INT_PIN) wakes us before
+        // the period is up
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(periodMs));
+    }
+}
+
+// Run the GPIO-driven controls on one snapshot. Caller holds engineMutex.
+static void applyGpioSnapshot(const GPIOCache& gpioCache) {
+    // BLE gesture detection BEFORE lever updates to suppress MIDI during gesture
+    bool bleGestureActive = false;
+    if (bleGestureControl) {
+        bool keyboardActiveForGesture = keyboardControl.anyKeyActive();
+        bleGestureActive = bleGestureControl->update(gpioCache.isU2PinLow(SWD1_RIGHT_PIN),
+                                                     gpioCache.isU2PinLow(SWD2_LEFT_PIN), keyboardActiveForGesture);
+    }
+
+    // Only update levers if gesture not active (cooldown already checked inside lever update)
+    if (!bleGestureActive) {
+        lever1.update(gpioCache);
+        lever2.update(gpioCache);
+    }
+
+    leverPush1.update(gpioCache);
+    leverPush2.update(gpioCache);
+    octaveControl.update(gpioCache);  // Pass cached GPIO data (no I2C overhead)
+    keyboardControl.updateKeyboardState(gpioCache);  // Pass cached GPIO data (no I2C overhead)
+}
+
+// Music engine: applies the scanner's events in order, then LED targets,
+// activity/sleep and MIDI output. Wakes when the scanner queues an event
+// (pin change, touch sample), and at the next key debounce deadline so a
+// press is accepted on time even between scans.
+[[noreturn]] void musicEngineTask(void *pvParameters) {
+    (void)pvParameters;
+    GPIOCache gpioCache = {0xFFFF, 0xFFFF, micros()};  // Latest snapshot (all released until the first one)
+    long debounceMs = -1;  // Taken under engineMutex at the end of each pass
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, debounceMs < 0 ? portMAX_DELAY : pdMS_TO_TICKS(debounceMs > 0 ? debounceMs : 1));
+
+        // Controls and keyboard run under engineMutex (shared with seqClockTask)
+        xSemaphoreTake(engineMutex, portMAX_DELAY);
+
+        // Deferred from the BLE task: if shape mode is disabled (strumPattern = 0), stop the arpeggiator
+        if (patternResetPending) {
+            patternResetPending = false;
+            if (chordSettings.strumPattern == 0) {
+                keyboardControl.stopArpeggiator();
+                SERIAL_PRINTLN("Arpeggiator stopped - shape mode disabled");
+            }
+        }
+
+        // Deferred from the BLE task: latency stats reset
+        if (midiLatency.applyPendingReset()) {
+            SERIAL_PRINTLN("Lat:Reset");
+        }
+
+        // Oldest first, each with its own hardware timestamp
+        bool gpioApplied = false;
+        InputEvent ev;
+        while (inputEvents.pop(ev)) {
+            if (ev.type == InputEvent::TOUCH_SAMPLE) {
+                touch.update((int)ev.touchRaw);
+            } else {
+                gpioCache = ev.gpio();
+                applyGpioSnapshot(gpioCache);
+                gpioApplied = true;
+            }
+        }
+        if (!gpioApplied) {
+            // No pin changed since the last snapshot, which still holds now:
+            // rerun on it so debounce deadlines, lever ramps and long presses advance
+            gpioCache.timestamp = micros();
+            applyGpioSnapshot(gpioCache);
+        }
+        armSequencerClock();  // Key presses may have started or moved a sequence
+        // KeyboardControl state read below the mutex is snapshotted here:
+        // seqClockTask may be running the scheduler once it is released
+        debounceMs = keyboardControl.debounceWaitMs();
+        const bool keyboardActive = keyboardControl.anyKeyActive();
+        // Arp running in latch mode counts as active (prevents IDLE BLE params from causing I2C glitch)
+        const bool arpActive = keyboardControl.isArpActive();
+        xSemaphoreGive(engineMutex);
+
         // Extract lever states from cached pin data (no I2C overhead, just bitwise operations)
         bool lever1Right = gpioCache.isU2PinLow(SWD1_RIGHT_PIN);
         bool lever2Right = gpioCache.isU2PinLow(SWD2_RIGHT_PIN);
@@ -1569,24 +1962,6 @@ void loop() {
         bool lever2Left = gpioCache.isU2PinLow(SWD2_LEFT_PIN);
         bool leverPush1Pressed = gpioCache.isU1PinLow(SWD1_CENTER_PIN);
         bool leverPush2Pressed = gpioCache.isU2PinLow(SWD2_CENTER_PIN);
-        
-        // BLE gesture detection BEFORE lever updates to suppress MIDI during gesture
-        bool bleGestureActive = false;
-        if (bleGestureControl) {
-            bool keyboardActiveForGesture = keyboardControl.anyKeyActive();
-            bleGestureActive = bleGestureControl->update(lever1Right, lever2Left, keyboardActiveForGesture);
-        }
-        
-        // Only update levers if gesture not active (cooldown already checked inside lever update)
-        if (!bleGestureActive) {
-            lever1.update();
-            lever2.update();
-        }
-        
-        leverPush1.update();
-        leverPush2.update();
-        octaveControl.update(gpioCache);  // Pass cached GPIO data (no I2C overhead)
-        keyboardControl.updateKeyboardState(gpioCache);  // Pass cached GPIO data (no I2C overhead)
 
         // Query touch sensor active state (affects LED behavior)
         bool touchActive = touch.isActive();
@@ -1678,9 +2053,6 @@ void loop() {
         leverPushWasPressed = leverPushIsPressed;        
 
         // Determine activity: touch active, any keyboard key, any pressed switch, or BLE keep-alive active
-        bool keyboardActive = keyboardControl.anyKeyActive();
-        // Arp running in latch mode counts as active (prevents IDLE BLE params from causing I2C glitch)
-        bool arpActive = keyboardControl.isArpActive();
         bool bleKeepAliveActive = bluetoothControllerPtr && bluetoothControllerPtr->isKeepAliveActive();
         
         // Prevent sleep during charging
@@ -1712,7 +2084,17 @@ void loop() {
                     saveChargingDebug("ENTER_SLEEP", usbNow, batteryState.isChargingMode, activelyCharging);
                     
                     deepSleepTriggered = true;
+                    inputScanPaused = true;
+                    // Sleep holds the engine: the sequencer clock is stopped
+                    // and seqClockTask waits, so only this task touches keyboardControl
+                    xSemaphoreTake(engineMutex, portMAX_DELAY);
+                    if (seqClockTimer) esp_timer_stop(seqClockTimer);
+                    seqClockArmed = false;
                     enterLightSleep(touch, keyboardControl, ledController, bluetoothControllerPtr, touchSettings, lastActivityMillis, PINK_LED_PWM_PIN, BLUE_LED_PWM_PIN, PINK_PWM_MAX, PWM_MAX, PINK_RAMP_UP_MS, PINK_RAMP_DOWN_MS, BLUE_RAMP_UP_MS, BLUE_RAMP_DOWN_MS);
+                    armSequencerClock();
+                    xSemaphoreGive(engineMutex);
+                    attachTouchEdgeInterrupt();
+                    inputScanPaused = false;
                 }
             }
         }
@@ -1725,10 +2107,14 @@ void loop() {
             lastDebugLog = millis();
         }
 
-        // Input scan rate: 5ms = 200Hz (2× faster than previous 10ms/100Hz)
-        // Bulk I2C optimization freed up 5ms per cycle (was 5-6ms I2C overhead, now ~0.4ms)
-        // Result: More responsive input, catches rapid note playing, smoother feel
-        vTaskDelay(5 / portTICK_PERIOD_MS);
+        // Top up the UART TX buffer with anything still queued (BLE CCs, bursts)
+        xSemaphoreTake(engineMutex, portMAX_DELAY);
+        midiOut.service();
+        xSemaphoreGive(engineMutex);
+
+        // Keeps the scanner at the active rate (it holds it INPUT_SETTLE_MS longer)
+        inputsActive = touchActive || keyboardActive || arpActive || pinkLedPressed || blueLeftPressed ||
+                       leverPushIsPressed;
     }
 }
 
@@ -0,0 +1,171 @@
+#ifndef MIDI_LATENCY_H
+#define MIDI_LATENCY_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// Fixed-bucket latency histogram (no allocation, O(1) record).
+// Samples past the last bucket land in an overflow bucket; max is exact.
+class LatencyHistogram {
+public:
+    static constexpr int BUCKETS = 128;
+
+    explicit LatencyHistogram(uint16_t bucketUs) : _bucketUs(bucketUs) { reset(); }
+
+    void record(unsigned long us) {
+        unsigned long index = us / _bucketUs;
+        if (index > BUCKETS) index = BUCKETS;
+        _counts[index]++;
+        _count++;
+        if (us > _max) _max = us;
+    }
+
+    void reset() {
+        memset(_counts, 0, sizeof(_counts));
+        _count = 0;
+        _max = 0;
+    }
+
+    uint32_t count() const { return _count; }
+    uint32_t max() const { return _max; }
+
+    // Upper edge of the bucket holding the pct-th percentile sample (us).
+    // Overflowed percentiles report the exact max.
+    uint32_t percentile(uint8_t pct) const {
+        if (_count == 0) return 0;
+        uint32_t rank = ((uint64_t)_count * pct + 99) / 100;
+        if (rank == 0) rank = 1;
+        uint32_t seen = 0;
+        for (int i = 0; i < BUCKETS; i++) {
+            seen += _counts[i];
+            if (seen >= rank) {
+                uint32_t edge = (uint32_t)(i + 1) * _bucketUs;
+                return edge < _max ? edge : _max;
+            }
+        }
+        return _max;
+    }
+
+private:
+    uint16_t _bucketUs;
+    uint32_t _counts[BUCKETS + 1];
+    uint32_t _count;
+    uint32_t _max;
+};
+
+// Scan -> MIDI latency for key-triggered notes, split by pipeline stage:
+//   debounce: GPIOCache snapshot that first saw the edge -> debounce accept
+//             (includes any wait in the scanner -> engine event ring)
+//   queue:    debounce accept -> first NoteOn queued by the MIDI output stage
+//   wire:     queued -> its last byte leaves the DIN port
+//   total:    snapshot -> last byte on the wire
+// Written only from the engine side (under engineMutex); readers
+// (serial/BLE) may see a partially updated set, which is fine for diagnostics.
+// Other tasks clear the stats with requestReset(), applied by the engine.
+class MidiLatencyStats {
+public:
+    static constexpr uint8_t STAGE_COUNT = 4;
+
+    LatencyHistogram debounce{250};
+    LatencyHistogram queue{20};
+    LatencyHistogram wire{160};
+    LatencyHistogram total{250};
+
+    // Called by KeyboardControl right before it plays a newly accepted key.
+    void beginEvent(unsigned long snapshotUs, unsigned long acceptUs) {
+        _snapshotUs = snapshotUs;
+        _acceptUs = acceptUs;
+        _pending = true;
+    }
+
+    // Called by the MIDI output stage when a NoteOn enters its queue. Only the
+    // first NoteOn after beginEvent() is attributed to the key press; returns
+    // true if this one was, so the stage can report its wire time later.
+    bool noteQueued(unsigned long queuedUs) {
+        if (!_pending) return false;
+        _pending = false;
+        _queuedUs = queuedUs;
+        _awaitingWire = true;
+        return true;
+    }
+
+    // Called once the attributed NoteOn's last byte has a known wire time.
+    void noteOnWire(unsigned long wireDoneUs) {
+        if (!_awaitingWire) return;
+        _awaitingWire = false;
+        debounce.record(_acceptUs - _snapshotUs);
+        queue.record(_queuedUs - _acceptUs);
+        wire.record(wireDoneUs - _queuedUs);
+        total.record(wireDoneUs - _snapshotUs);
+    }
+
+    // Key press produced no immediate NoteOn (e.g. ARP waits for its clock).
+    void endEvent() { _pending = false; }
+
+    uint32_t events() const { return total.count(); }
+
+    // Any task: clear the stats at the engine's next applyPendingReset()
+    void requestReset() { _resetRequested.store(true, std::memory_order_release); }
+
+    // Engine side: returns true if a requested reset was applied
+    bool applyPendingReset() {
+        if (!_resetRequested.exchange(false, std::memory_order_acquire)) return false;
+        reset();
+        return true;
+    }
+
+    void reset() {
+        debounce.reset();
+        queue.reset();
+        wire.reset();
+        total.reset();
+        _pending = false;
+        _awaitingWire = false;
+    }
+
+    // Compact single line for serial, times in ms (p50/p99/max):
+    // "Lat n12 D10.25/10.50/10.61 Q0.02/0.04/0.04 W0.96/1.92/2.10 T11.2/12.5/12.6"
+    void format(char* buf, size_t len) const {
+        snprintf(buf, len, "Lat n%lu D%.2f/%.2f/%.2f Q%.2f/%.2f/%.2f W%.2f/%.2f/%.2f T%.1f/%.1f/%.1f",
+                 (unsigned long)events(),
+                 debounce.percentile(50) / 1000.0f, debounce.percentile(99) / 1000.0f, debounce.max() / 1000.0f,
+                 queue.percentile(50) / 1000.0f, queue.percentile(99) / 1000.0f, queue.max() / 1000.0f,
+                 wire.percentile(50) / 1000.0f, wire.percentile(99) / 1000.0f, wire.max() / 1000.0f,
+                 total.percentile(50) / 1000.0f, total.percentile(99) / 1000.0f, total.max() / 1000.0f);
+    }
+
+    // BLE packet: [version(1), stageCount(1), events(4 LE)] then per stage
+    // (debounce, queue, wire, total): p50, p99, max as uint16 LE in 10us units.
+    static constexpr size_t PACKET_SIZE = 6 + STAGE_COUNT * 6;
+
+    size_t pack(uint8_t* out) const {
+        out[0] = 1;
+        out[1] = STAGE_COUNT;
+        uint32_t n = events();
+        memcpy(&out[2], &n, 4);
+        const LatencyHistogram* stages[STAGE_COUNT] = {&debounce, &queue, &wire, &total};
+        size_t pos = 6;
+        for (const LatencyHistogram* h : stages) {
+            const uint32_t values[3] = {h->percentile(50), h->percentile(99), h->max()};
+            for (uint32_t us : values) {
+                uint32_t units = us / 10;
+                uint16_t v = units > 0xFFFF ? 0xFFFF : (uint16_t)units;
+                memcpy(&out[pos], &v, 2);
+                pos += 2;
+            }
+        }
+        return pos;
+    }
+
+private:
+    std::atomic<bool> _resetRequested{false};
+    unsigned long _snapshotUs = 0;
+    unsigned long _acceptUs = 0;
+    unsigned long _queuedUs = 0;
+    bool _pending = false;
+    bool _awaitingWire = false;
+};
+
+extern MidiLatencyStats midiLatency;
+
+#endif
@@ -0,0 +1,319 @@
+#ifndef MIDI_OUTPUT_H
+#define MIDI_OUTPUT_H
+
+#include <Arduino.h>
+#include <objects/SpscRing.h>
+#include <midi/MidiLatency.h>
+
+// MIDI output stage used as the MidiTransport for every control.
+// send* encodes the message into a lock-free byte ring and returns without
+// touching the UART; service() moves whatever the UART driver's TX buffer can
+// take right now (never blocking), and the UART TX interrupt drains that
+// buffer onto the DIN port. A full ring drops the message and counts it
+// instead of stalling the scan.
+//
+// Bandwidth: the encoder applies running status (NoteOffs go out as
+// velocity-0 NoteOns so chords stay on one status byte).
+//
+// Priority: two lanes share the link.
+//   note lane:       NoteOn/NoteOff and channel-mode CCs (120-127, e.g. the
+//                    boot panic). Encoded straight into the byte ring; never
+//                    thinned, only dropped if the ring itself is full.
+//   continuous lane: all other CCs and channel pressure. Held as
+//                    latest-value-per-controller and
+//                    released at the end of the scan tick, only while the
+//                    note lane is empty and the modeled wire backlog is under
+//                    CONTINUOUS_BACKLOG_BYTES. A newer value replaces a held
+//                    one: within the tick that is coalescing, after a missed
+//                    tick it is a lost update (lostUpdates()). With
+//                    every slot held, a new controller is parked in a
+//                    latest-value table covering every (channel,
+//                    controller) and takes a slot as one frees up, so the
+//                    latest value of every controller still reaches the wire.
+// Notes therefore never queue behind a CC flood; CCs sent in the same tick as
+// a note go out after it.
+//
+// Threading: send*/service()/flush() belong to the engine side:
+// musicEngineTask and seqClockTask, one at a time under engineMutex (or setup
+// before either starts). Other tasks (BLE callbacks) use post*, which goes through a
+// separate SPSC ring merged by the next service().
+//
+// A model of the DIN link (31250 baud, 10 bits per byte = 320us) gives each
+// byte's on-wire time without hardware support. NoteOns feed midiLatency.
+template<typename Port>
+class MidiOutput {
+public:
+    static constexpr unsigned long US_PER_BYTE = 320;
+    static constexpr size_t TX_RING_SIZE = 1024;  // ~330ms of back-to-back DIN traffic
+    static constexpr size_t POST_RING_SIZE = 64;
+    static constexpr uint8_t CC_SLOTS = 16;       // Distinct controllers held in release order
+    static constexpr uint16_t PARK_SIZE = 16 * 128;  // Channel x controller (pressure at 127)
+    // Continuous lane waits while more than this is still ahead of it on the
+    // wire: about one 5ms scan of link time, enough to keep the link busy
+    // between ticks while bounding how long a new note can sit behind CCs
+    static constexpr unsigned long CONTINUOUS_BACKLOG_BYTES = 16;
+    // Re-send the status byte at least this often so a receiver plugged in
+    // mid-stream resyncs quickly
+    static constexpr unsigned long RUNNING_STATUS_REFRESH_US = 100000;
+
+    explicit MidiOutput(Port& port) : _port(port) {}
+
+    void sendNoteOn(uint8_t note, uint8_t velocity, uint8_t channel) {
+        const bool tracked = midiLatency.noteQueued(micros());
+        if (encode(0x90 | ((channel - 1) & 0x0F), note, velocity) && tracked) {
+            _latencyMark = _tx.headIndex();  // Index one past the NoteOn's last byte
+            _latencyArmed = true;
+        }
+        drain();
+    }
+
+    void sendNoteOff(uint8_t note, uint8_t velocity, uint8_t channel) {
+        if (velocity == 0) {
+            encode(0x90 | ((channel - 1) & 0x0F), note, 0);  // NoteOn vel 0 == NoteOff, keeps running status
+        } else {
+            encode(0x80 | ((channel - 1) & 0x0F), note, velocity);
+        }
+        drain();
+    }
+
+    void sendControlChange(uint8_t number, uint8_t value, uint8_t channel) {
+        queueControlChange(0xB0 | ((channel - 1) & 0x0F), number, value);
+    }
+
+    // Channel pressure rides the continuous lane like a CC (one held slot per channel)
+    void sendAfterTouch(uint8_t pressure, uint8_t channel) {
+        queueControlChange(0xD0 | ((channel - 1) & 0x0F), 0, pressure);
+    }
+
+    // Safe from any single task other than the owner; sent on its next service()
+    bool postControlChange(uint8_t number, uint8_t value, uint8_t channel) {
+        const ChannelMessage msg = {(uint8_t)(0xB0 | ((channel - 1) & 0x0F)), (uint8_t)(number & 0x7F),
+                                    (uint8_t)(value & 0x7F)};
+        if (!_post.push(msg)) {
+            _droppedMessages++;
+            return false;
+        }
+        return true;
+    }
+
+    // End of scan tick: merge posted CCs, hand queued notes to the UART, then
+    // release held CCs if the link has room. Never blocks. Call once per scan.
+    void service() {
+        ChannelMessage posted;
+        while (_post.pop(posted)) {
+            queueControlChange(posted.status, posted.data1, posted.data2);
+        }
+        drain();
+        releaseControlChanges();
+        for (uint8_t i = 0; i < _heldCount; i++) {
+            _held[i].missedTick = true;
+        }
+    }
+
+    // Blocking: wait until everything queued, both lanes, is in the UART
+    // driver (boot panic)
+    void flush() {
+        service();
+        while (!_tx.empty() || _heldCount > 0) {
+            delay(1);
+            drain();
+            releaseControlChanges();
+        }
+    }
+
+    size_t pendingBytes() const { return _tx.size(); }
+    uint32_t droppedMessages() const { return _droppedMessages.load(std::memory_order_relaxed); }
+    uint32_t coalescedMessages() const { return _coalescedMessages; }
+    uint32_t lostUpdates() const { return _lostUpdates; }
+    uint32_t runningStatusHits() const { return _runningStatusHits; }
+    uint32_t parkedControls() const { return _parkedControls; }  // Controllers that waited for a slot
+
+private:
+    struct ChannelMessage {
+        uint8_t status;
+        uint8_t data1;
+        uint8_t data2;
+    };
+
+    struct HeldControl {
+        uint8_t status;
+        uint8_t number;
+        uint8_t value;
+        bool missedTick;  // Already waited through one service() (back-pressure)
+    };
+
+    // Append one channel message to the ring, omitting the status byte when
+    // it matches the last one queued. Program change and channel pressure
+    // carry only data1.
+    bool encode(uint8_t status, uint8_t data1, uint8_t data2) {
+        const unsigned long nowUs = micros();
+        if (nowUs - _statusSentUs >= RUNNING_STATUS_REFRESH_US) {
+            _runningStatus = 0;
+        }
+        uint8_t bytes[3];
+        size_t count = 0;
+        if (status != _runningStatus) bytes[count++] = status;
+        bytes[count++] = data1 & 0x7F;
+        if (!isTwoByte(status)) bytes[count++] = data2 & 0x7F;
+        if (!_tx.pushAll(bytes, count)) {
+            _droppedMessages++;
+            return false;
+        }
+        if (bytes[0] == status) {
+            _runningStatus = status;
+            _statusSentUs = nowUs;
+        } else {
+            _runningStatusHits++;
+        }
+        return true;
+    }
+
+    static bool isTwoByte(uint8_t status) {
+        return (status & 0xE0) == 0xC0;  // 0xC0 program change, 0xD0 channel pressure
+    }
+
+    void queueControlChange(uint8_t status, uint8_t number, uint8_t value) {
+        if (number >= 120) {
+            // Channel mode messages (All Notes Off etc.) ride the note lane
+            encode(status, number, value);
+            drain();
+            return;
+        }
+        for (uint8_t i = 0; i < _heldCount; i++) {
+            if (_held[i].status == status && _held[i].number == number) {
+                _held[i].value = value;
+                if (_held[i].missedTick) {
+                    _lostUpdates++;
+                } else {
+                    _coalescedMessages++;
+                }
+                return;
+            }
+        }
+        if (_heldCount == CC_SLOTS) {
+            park(status, number, value);  // More distinct controllers than slots under back-pressure
+            return;
+        }
+        _held[_heldCount++] = {status, number, value, false};
+    }
+
+    // Move held CCs (oldest first) into the ring while the note lane is
+    // empty and the wire backlog is short
+    void releaseControlChanges() {
+        uint8_t released = 0;
+        while (released < _heldCount && _tx.empty() && wireBacklogBytes() < CONTINUOUS_BACKLOG_BYTES) {
+            const HeldControl& cc = _held[released];
+            const bool sent = isTwoByte(cc.status) ? encode(cc.status, cc.value, 0)
+                                                   : encode(cc.status, cc.number, cc.value);
+            if (!sent) break;
+            released++;
+            drain();
+        }
+        if (released == 0) return;
+        for (uint8_t i = released; i < _heldCount; i++) {
+            _held[i - released] = _held[i];
+        }
+        _heldCount -= released;
+        unpark();
+    }
+
+    static uint16_t parkIndex(uint8_t status, uint8_t number) {
+        return ((status & 0x0F) << 7) | (isTwoByte(status) ? 127 : number);
+    }
+
+    void park(uint8_t status, uint8_t number, uint8_t value) {
+        const uint16_t i = parkIndex(status, number);
+        const uint32_t bit = 1UL << (i & 31);
+        if (_parked[i >> 5] & bit) {
+            _lostUpdates++;  // Replaces a parked value that never went out
+        } else {
+            _parked[i >> 5] |= bit;
+            _parkedCount++;
+            _parkedControls++;
+        }
+        _parkedValue[i] = value;
+    }
+
+    // Move parked controllers into free slots, resuming the scan where the
+    // last refill stopped so every parked controller gets its turn
+    void unpark() {
+        while (_parkedCount > 0 && _heldCount < CC_SLOTS) {
+            const uint16_t i = _parkCursor;
+            const uint32_t ahead = _parked[i >> 5] >> (i & 31);
+            if (ahead == 0) {
+                _parkCursor = ((i | 31) + 1) & (PARK_SIZE - 1);  // Rest of this word is empty
+                continue;
+            }
+            const uint16_t j = i + __builtin_ctz(ahead);
+            _parkCursor = (j + 1) & (PARK_SIZE - 1);
+            _parked[j >> 5] &= ~(1UL << (j & 31));
+            _parkedCount--;
+            const uint8_t channel = j >> 7;
+            const uint8_t controller = j & 127;
+            if (controller == 127) {
+                _held[_heldCount++] = {(uint8_t)(0xD0 | channel), 0, _parkedValue[j], true};
+            } else {
+                _held[_heldCount++] = {(uint8_t)(0xB0 | channel), controller, _parkedValue[j], true};
+            }
+        }
+    }
+
+    unsigned long wireBacklogBytes() const {
+        const long aheadUs = (long)(_wireFreeUs - micros());
+        return aheadUs > 0 ? (unsigned long)aheadUs / US_PER_BYTE : 0;
+    }
+
+    // Hand as many queued bytes as the UART TX buffer has room for
+    void drain() {
+        const uint8_t* data;
+        size_t run;
+        while ((run = _tx.peekContiguous(data)) > 0) {
+            const int room = _port.availableForWrite();
+            if (room <= 0) break;
+            if (run > (size_t)room) run = room;
+
+            const uint32_t first = _tx.tailIndex();
+            const size_t written = _port.write(data, run);
+            if (written == 0) break;
+            _tx.consume(written);
+            onWire(first, written);
+            if (written < run) break;
+        }
+    }
+
+    // Advance the wire model for count bytes handed to the UART, starting at
+    // ring index first, and resolve the tracked NoteOn if it was among them.
+    void onWire(uint32_t first, size_t count) {
+        const unsigned long nowUs = micros();
+        if ((long)(_wireFreeUs - nowUs) < 0) {
+            _wireFreeUs = nowUs;  // Link was idle
+        }
+        if (_latencyArmed && _latencyMark - first <= count) {
+            _latencyArmed = false;
+            midiLatency.noteOnWire(_wireFreeUs + (_latencyMark - first) * US_PER_BYTE);
+        }
+        _wireFreeUs += count * US_PER_BYTE;
+    }
+
+    Port& _port;
+    SpscRing<uint8_t, TX_RING_SIZE> _tx;
+    SpscRing<ChannelMessage, POST_RING_SIZE> _post;
+    unsigned long _wireFreeUs = 0;
+    uint32_t _latencyMark = 0;
+    bool _latencyArmed = false;
+    HeldControl _held[CC_SLOTS];
+    uint8_t _heldCount = 0;
+    uint8_t _runningStatus = 0;
+    unsigned long _statusSentUs = 0;
+    std::atomic<uint32_t> _droppedMessages{0};  // Bumped by both sides
+    uint32_t _coalescedMessages = 0;
+    uint32_t _lostUpdates = 0;
+    uint32_t _runningStatusHits = 0;
+    uint8_t _parkedValue[PARK_SIZE];
+    uint32_t _parked[PARK_SIZE / 32] = {};  // Bit per parkIndex() with a value waiting
+    uint16_t _parkedCount = 0;
+    uint16_t _parkCursor = 0;
+    uint32_t _parkedControls = 0;
+};
+
+#endif
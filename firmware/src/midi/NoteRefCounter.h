@@ -0,0 +1,76 @@
+#ifndef NOTE_REF_COUNTER_H
+#define NOTE_REF_COUNTER_H
+
+#include <Arduino.h>
+
+// Per-note reference counts between the music engine and the MIDI transport.
+// Several holders can want the same note at once: overlapping chord
+// voicings and strum voices, pitch-bend overlap, sustain tails, the arp.
+// The transport sees a NoteOn only when a note starts sounding (0 -> 1) and
+// a NoteOff only when its last holder lets go (1 -> 0), so one holder's
+// release never cuts the note for the others and duplicate NoteOns never
+// reach the wire. Every holder must pair its noteOn()/noteOff() exactly.
+//
+// Counts are per note number: KB1 plays every note on one channel. A bitmap
+// of sounding notes makes "anything sounding?" O(1) and allNotesOff() cost
+// only the notes actually sounding.
+//
+// Not thread-safe: engine side only (musicEngineTask / seqClockTask under
+// engineMutex), like the transport's send*.
+template<typename Transport>
+class NoteRefCounter {
+public:
+    explicit NoteRefCounter(Transport& out) : _out(out) {}
+
+    void noteOn(uint8_t note, uint8_t velocity, uint8_t channel) {
+        note &= 0x7F;
+        if (_refs[note] == 0xFF) return;  // Saturated: a holder leaks, never wrap to silent
+        if (_refs[note]++ > 0) {
+            _mergedOns++;
+            return;
+        }
+        _sounding[note >> 5] |= 1UL << (note & 31);
+        _soundingCount++;
+        _out.sendNoteOn(note, velocity, channel);
+    }
+
+    void noteOff(uint8_t note, uint8_t velocity, uint8_t channel) {
+        note &= 0x7F;
+        if (_refs[note] == 0) {
+            _strayOffs++;  // Nothing holds it: the off was already sent
+            return;
+        }
+        if (--_refs[note] > 0) return;
+        _sounding[note >> 5] &= ~(1UL << (note & 31));
+        _soundingCount--;
+        _out.sendNoteOff(note, velocity, channel);
+    }
+
+    // Silence everything sounding and forget all holders
+    void allNotesOff(uint8_t channel) {
+        for (uint8_t w = 0; w < 4; w++) {
+            for (uint32_t bits = _sounding[w]; bits; bits &= bits - 1) {
+                const uint8_t note = (uint8_t)(w * 32 + __builtin_ctz(bits));
+                _refs[note] = 0;
+                _out.sendNoteOff(note, 0, channel);
+            }
+            _sounding[w] = 0;
+        }
+        _soundingCount = 0;
+    }
+
+    bool isSounding(uint8_t note) const { return _refs[note & 0x7F] > 0; }
+    uint8_t soundingCount() const { return _soundingCount; }
+    uint32_t mergedOns() const { return _mergedOns; }  // NoteOns absorbed by a note already sounding
+    uint32_t strayOffs() const { return _strayOffs; }  // NoteOffs for notes nothing held
+
+private:
+    Transport& _out;
+    uint8_t _refs[128] = {};
+    uint32_t _sounding[4] = {};
+    uint8_t _soundingCount = 0;
+    uint32_t _mergedOns = 0;
+    uint32_t _strayOffs = 0;
+};
+
+#endif
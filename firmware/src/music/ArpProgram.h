@@ -0,0 +1,212 @@
+#ifndef ARP_PROGRAM_H
+#define ARP_PROGRAM_H
+
+#include <Arduino.h>
+
+// Arpeggiator step program: the note source (chord intervals after voicing,
+// or the user sequence), pattern, velocity spread and swing compiled into the
+// flat cycle of steps the arp plays, so a step is one array read.
+//
+// The owner fills Inputs every step and compiles again only when they differ
+// from the ones the program was built from. The root is not an input (chord
+// steps hold intervals), so transposing never rebuilds. Random patterns
+// reshuffle at every loop, as before.
+//
+// Patterns (ChordSettings::strumPattern):
+//   chord source: 2 down, 3 up-down ping-pong, 4 contract (edges inward),
+//                 5 expand (centre outward), 6 random, others up
+//   user source:  5 (or a single note) press order; otherwise sorted by
+//                 pitch, then 2 down, 3 ping-pong, 6 random, others up, with
+//                 4 and 7 taking the sorted notes edges-inward first
+//
+// Also the arp preview: length() and step() list exactly what will play.
+class ArpProgram {
+public:
+    static constexpr uint8_t MAX_SOURCE = 16;
+    static constexpr uint8_t MAX_STEPS = 2 * MAX_SOURCE - 2;  // Ping-pong unrolled
+
+    struct Step {
+        int16_t pitch;     // Interval from the root (chord source) or MIDI note (user source)
+        uint8_t velocity;
+        uint8_t index;     // Note's position in the (sorted) source, for the serial log
+        uint16_t delayMs;  // Until the next step; the note is held for all of it
+    };
+
+    // Everything a program depends on
+    struct Inputs {
+        bool user;  // User sequence rather than chord intervals
+        int pattern;
+        uint8_t count;
+        int16_t source[MAX_SOURCE];
+        int velocity;  // Keyboard velocity and spread, through the owner's velocity function
+        int spread;
+        int speedMs;   // Step length (abs of ChordSettings::strumSpeed)
+        int swing;     // Extra length of steps before odd-indexed notes, in %/2 of speedMs
+
+        bool operator==(const Inputs& o) const {
+            if (user != o.user || pattern != o.pattern || count != o.count || velocity != o.velocity ||
+                spread != o.spread || speedMs != o.speedMs || swing != o.swing) {
+                return false;
+            }
+            for (uint8_t i = 0; i < count; i++) {
+                if (source[i] != o.source[i]) return false;
+            }
+            return true;
+        }
+    };
+
+    bool matches(const Inputs& in) const { return _valid && in == _in; }
+
+    // Build the cycle. velocityOf(index, count) gives a note's velocity by
+    // its position in the source. The cursor restarts on a new pattern or
+    // source kind and otherwise keeps its place (wrapping if it fell off).
+    template<typename VelocityFn>
+    void compile(const Inputs& in, VelocityFn velocityOf) {
+        const bool restart = !_valid || in.pattern != _in.pattern || in.user != _in.user;
+        _in = in;
+        if (_in.count > MAX_SOURCE) _in.count = MAX_SOURCE;
+        _valid = true;
+        const uint8_t n = _in.count;
+
+        for (uint8_t i = 0; i < n; i++) _pitch[i] = _in.source[i];
+        const int p = _in.pattern;
+        Order order = UP;
+        if (_in.user && (p == 5 || n == 1)) {
+            order = UP;  // Press order
+        } else {
+            if (_in.user) {
+                sortPitches(n);
+                if (p == 4 || p == 7) edgesInward(n);
+            }
+            if (p == 2) order = DOWN;
+            else if (p == 3) order = PING_PONG;
+            else if (p == 6) order = RANDOM;
+            else if (!_in.user && p == 4) order = CONTRACT;
+            else if (!_in.user && p == 5) order = EXPAND;
+        }
+        for (uint8_t i = 0; i < n; i++) _velocity[i] = (uint8_t)velocityOf(i, n);
+        _order = order;
+        buildSteps();
+        if (restart || _cursor >= _length) _cursor = 0;
+        _compiles++;
+    }
+
+    // Force the next matches() to fail (fresh shuffle, cursor at the start)
+    void invalidate() {
+        _valid = false;
+        _cursor = 0;
+    }
+
+    // Step at the cursor, moving on; a random program reshuffles as it loops
+    const Step& next() {
+        const Step& step = _steps[_cursor];
+        if (++_cursor >= _length) {
+            _cursor = 0;
+            if (_order == RANDOM) {
+                _lastStep = step;  // Rebuilding overwrites _steps
+                buildSteps();
+                return _lastStep;
+            }
+        }
+        return step;
+    }
+
+    uint8_t length() const { return _length; }
+    uint8_t position() const { return _cursor; }
+    const Step& step(uint8_t i) const { return _steps[i]; }
+    uint32_t compiles() const { return _compiles; }
+
+private:
+    enum Order : uint8_t { UP, DOWN, PING_PONG, CONTRACT, EXPAND, RANDOM };
+
+    // Insertion sort ascending by pitch (at most MAX_SOURCE notes)
+    void sortPitches(uint8_t n) {
+        for (int i = 1; i < n; i++) {
+            const int16_t key = _pitch[i];
+            int j = i - 1;
+            while (j >= 0 && _pitch[j] > key) {
+                _pitch[j + 1] = _pitch[j];
+                j--;
+            }
+            _pitch[j + 1] = key;
+        }
+    }
+
+    // [C3,E3,G3,B3] -> [C3,B3,E3,G3]
+    void edgesInward(uint8_t n) {
+        int16_t reordered[MAX_SOURCE];
+        int lo = 0, hi = n - 1, k = 0;
+        while (lo <= hi) {
+            reordered[k++] = _pitch[lo++];
+            if (lo <= hi) reordered[k++] = _pitch[hi--];
+        }
+        memcpy(_pitch, reordered, n * sizeof(int16_t));
+    }
+
+    void buildSteps() {
+        const uint8_t n = _in.count;
+        uint8_t order[MAX_STEPS];
+        uint8_t len = 0;
+        switch (_order) {
+            case DOWN:
+                for (int i = n - 1; i >= 0; i--) order[len++] = i;
+                break;
+            case PING_PONG:
+                for (int i = 0; i < n; i++) order[len++] = i;
+                for (int i = n - 2; i >= 1; i--) order[len++] = i;
+                break;
+            case CONTRACT: {
+                int lo = 0, hi = n - 1;
+                while (lo <= hi) {
+                    order[len++] = lo++;
+                    if (lo <= hi) order[len++] = hi--;
+                }
+                break;
+            }
+            case EXPAND: {
+                const int mid = (n - 1) / 2;
+                order[len++] = mid;
+                for (int d = 1; d < n && len < n; d++) {
+                    if (mid + d < n) order[len++] = mid + d;
+                    if (mid - d >= 0 && len < n) order[len++] = mid - d;
+                }
+                break;
+            }
+            case RANDOM:
+                // Fisher-Yates
+                for (int i = 0; i < n; i++) order[len++] = i;
+                for (int i = n - 1; i > 0; i--) {
+                    const int j = random(0, i + 1);
+                    const uint8_t tmp = order[i];
+                    order[i] = order[j];
+                    order[j] = tmp;
+                }
+                break;
+            default:
+                for (int i = 0; i < n; i++) order[len++] = i;
+                break;
+        }
+        _length = len;
+
+        // Swing lengthens the gap before odd-indexed notes
+        const int swingMs = _in.swing > 0 ? (_in.speedMs * _in.swing) / 200 : 0;
+        for (uint8_t k = 0; k < len; k++) {
+            const uint8_t i = order[k];
+            const uint8_t nextIndex = order[k + 1 < len ? k + 1 : 0];
+            _steps[k] = {_pitch[i], _velocity[i], i, (uint16_t)(_in.speedMs + ((nextIndex & 1) ? swingMs : 0))};
+        }
+    }
+
+    Inputs _in;
+    bool _valid = false;
+    Order _order = UP;
+    int16_t _pitch[MAX_SOURCE];    // Source after sorting/reordering
+    uint8_t _velocity[MAX_SOURCE];
+    Step _steps[MAX_STEPS];
+    Step _lastStep;
+    uint8_t _length = 0;
+    uint8_t _cursor = 0;
+    uint32_t _compiles = 0;
+};
+
+#endif
@@ -1,41 +1,93 @@
 #include <music/ScaleManager.h>
 #include <objects/Globals.h>
 
-const ScaleDefinition ScaleManager::_allScales[] = {
-    {ScaleType::CHROMATIC, "Chromatic", {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}},
-    {ScaleType::MAJOR, "Major", {0, 2, 4, 5, 7, 9, 11}},
-    {ScaleType::MINOR, "Minor", {0, 2, 3, 5, 7, 8, 10}},
-    {ScaleType::HARMONIC_MINOR, "Harmonic Minor", {0, 2, 3, 5, 7, 8, 11}},
-    {ScaleType::MELODIC_MINOR_ASC, "Melodic Minor", {0, 2, 3, 5, 7, 9, 11}},
-    {ScaleType::PENTATONIC_MAJOR, "Pentatonic Major", {0, 2, 4, 7, 9}},
-    {ScaleType::PENTATONIC_MINOR, "Pentatonic Minor", {0, 3, 5, 7, 10}},
-    {ScaleType::BLUES, "Blues Minor", {0, 3, 5, 6, 7, 10}},
-    {ScaleType::DORIAN, "Dorian", {0, 2, 3, 5, 7, 9, 10}},
-    {ScaleType::PHRYGIAN, "Phrygian", {0, 1, 3, 5, 7, 8, 10}},
-    {ScaleType::LYDIAN, "Lydian", {0, 2, 4, 6, 7, 9, 11}},
-    {ScaleType::MIXOLYDIAN, "Mixolydian", {0, 2, 4, 5, 7, 9, 10}},
-    {ScaleType::LOCRIAN, "Locrian", {0, 1, 3, 5, 6, 8, 10}},
-    {ScaleType::PHRYGIAN_DOMINANT, "Phrygian Dominant", {0, 1, 4, 5, 7, 8, 10}},
-    {ScaleType::WHOLE_TONE, "Whole Tone", {0, 2, 4, 6, 8, 10}},
-    {ScaleType::DIMINISHED, "Diminished", {0, 2, 3, 5, 6, 8, 9, 11}},
-    {ScaleType::BLUES_MAJOR, "Blues Major", {0, 2, 3, 4, 7, 9}},
-    {ScaleType::HIRAJOSHI, "Hirajoshi", {0, 2, 3, 7, 8}},
-    {ScaleType::IN_SEN, "In Sen", {0, 1, 5, 7, 10}},
-    {ScaleType::DOUBLE_HARMONIC, "Double Harmonic", {0, 1, 4, 5, 7, 8, 11}},
-    {ScaleType::SUPER_LOCRIAN, "Super Locrian", {0, 1, 3, 4, 6, 8, 10}}
+namespace {
+
+// --- Compile-time table generation ---
+
+constexpr bool isWhiteKey(int note) {
+    // C, C#, D, D#, E, F, F#, G, G#, A, A#, B
+    return (0xAB5 >> (note % 12)) & 1;
+}
+
+constexpr int closestWhiteKey(int note) {
+    int up = note;
+    int down = note;
+    while (up <= 127 || down >= 0) {
+        if (up <= 127 && isWhiteKey(up)) return up;
+        if (down >= 0 && isWhiteKey(down)) return down;
+        ++up;
+        --down;
+    }
+    return note;
+}
+
+// Nearest scale offset to distance (note - root), searching two octaves
+// either side of the root like the run-time search; ties go to the lower note
+constexpr int nearestScaleOffset(const ScaleDefinition& scale, int distance) {
+    int best = 0;
+    int minDistance = 1000;
+    for (int octaveOffset = -2; octaveOffset <= 2; ++octaveOffset) {
+        for (int i = 0; i < scale.count; i++) {
+            const int candidate = scale.intervals[i] + octaveOffset * 12;
+            const int d = distance > candidate ? distance - candidate : candidate - distance;
+            if (d < minDistance || (d == minDistance && candidate < best)) {
+                minDistance = d;
+                best = candidate;
+            }
+        }
+    }
+    return best;
+}
+
+struct GeneratedTables {
+    ScaleManager::ScaleTable scales[ScaleManager::SCALE_COUNT];
+    uint8_t whiteKey[128];  // Note -> nearest white key
 };
 
+constexpr GeneratedTables generateTables() {
+    GeneratedTables t{};
+    for (int s = 0; s < ScaleManager::SCALE_COUNT; s++) {
+        const ScaleDefinition& scale = ScaleManager::_allScales[s];
+        for (int i = 0; i < ScaleManager::OFFSET_SPAN; i++) {
+            t.scales[s].offset[i] = nearestScaleOffset(scale, i - 127);
+        }
+        for (int key = 0; key < ScaleManager::COMPACT_KEYS; key++) {
+            // Which scale degree and octave
+            t.scales[s].compactOffset[key] = scale.intervals[key % scale.count] + (key / scale.count) * 12;
+        }
+    }
+    for (int note = 0; note < 128; note++) {
+        t.whiteKey[note] = closestWhiteKey(note);
+    }
+    return t;
+}
+
+constexpr bool scalesInTypeOrder() {
+    for (int s = 0; s < ScaleManager::SCALE_COUNT; s++) {
+        if ((int)ScaleManager::_allScales[s].type != s) return false;
+    }
+    return true;
+}
+static_assert(scalesInTypeOrder(), "_allScales must be indexed by ScaleType");
+
+constexpr GeneratedTables TABLES = generateTables();
+
+}  // namespace
+
 ScaleManager::ScaleManager(ScaleSettings& settings) :
     _settings(settings),
     _whiteKeysQuantize(true) {
-    updateScaleIntervals();
+    setScale(_settings.scaleType);
 }
 
 void ScaleManager::setScale(ScaleType type) {
     if (_settings.scaleType != type) {
         _settings.scaleType = type;
     }
-    updateScaleIntervals();
+    SERIAL_PRINTLN(static_cast<int>(_settings.scaleType));
+    const int index = static_cast<int>(_settings.scaleType);
+    _table.store(index >= 0 && index < SCALE_COUNT ? &TABLES.scales[index] : nullptr, std::memory_order_release);
 }
 
 void ScaleManager::setRootNote(int root) {
@@ -49,54 +101,53 @@ int ScaleManager::quantizeNote(int note) const {
         return note;
     }
 
+    // Below 0 / above 127 quantize like the nearest valid note
+    int source = constrain(note, 0, 127);
     if (_whiteKeysQuantize) {
-        int closestWhiteKey = getClosestWhiteKey(note);
-        return getClosestNoteInScale(closestWhiteKey, _currentScaleIntervals, _settings.rootNote);
+        source = TABLES.whiteKey[source];
+    }
+    const ScaleTable* table = _table.load(std::memory_order_acquire);
+    if (!table) {
+        return source;
     }
 
-    return getClosestNoteInScale(note, _currentScaleIntervals, _settings.rootNote);
+    const int root = _settings.rootNote;
+    if (root >= 0 && root <= 127) {
+        const int quantized = root + table->offset[source - root + 127];
+        if (quantized >= 0 && quantized <= 127) {
+            return quantized;
+        }
+    }
+    // Nearest scale note is outside the MIDI range (roots near either end):
+    // search among the notes that exist
+    return getClosestNoteInScale(source, _allScales[table - TABLES.scales], root);
 }
 
 int ScaleManager::getCompactModeNote(int keyIndex) const {
     // In compact mode, map white key indices to sequential scale degrees
-    if (_currentScaleIntervals.empty()) {
+    const ScaleTable* table = _table.load(std::memory_order_acquire);
+    if (!table) {
         return _settings.rootNote + keyIndex; // Fallback to chromatic
     }
-    
-    // Calculate which scale degree and octave
-    int scaleSize = _currentScaleIntervals.size();
-    int scaleDegree = keyIndex % scaleSize;
-    int octaveOffset = keyIndex / scaleSize;
-    
-    // Return root + interval + octave offset
-    return _settings.rootNote + _currentScaleIntervals[scaleDegree] + (octaveOffset * 12);
-}
-
-void ScaleManager::updateScaleIntervals() {
-    _currentScaleIntervals.clear();
-    SERIAL_PRINTLN(static_cast<int>(_settings.scaleType));
-    for (const auto& scale : _allScales) {
-        if (scale.type == _settings.scaleType) {
-            _currentScaleIntervals = scale.intervals;
-            break;
-        }
+    if (keyIndex < COMPACT_KEYS) {
+        return _settings.rootNote + table->compactOffset[keyIndex];
     }
+    const ScaleDefinition& scale = _allScales[table - TABLES.scales];
+    return _settings.rootNote + scale.intervals[keyIndex % scale.count] + (keyIndex / scale.count) * 12;
 }
 
-int ScaleManager::getClosestNoteInScale(int note, const std::vector<int>& intervals, int rootNote) {
+int ScaleManager::getClosestNoteInScale(int note, const ScaleDefinition& scale, int rootNote) {
     int bestNote = -1;
     int minDistance = 1000;
 
     // Search across multiple octaves to find best match
     for (int octaveOffset = -2; octaveOffset <= 2; ++octaveOffset) {
-        for (int interval : intervals) {
-            int candidate = rootNote + interval + (octaveOffset * 12);
+        for (int i = 0; i < scale.count; i++) {
+            int candidate = rootNote + scale.intervals[i] + (octaveOffset * 12);
 
             if (candidate < 0 || candidate > 127)
                 continue;
 
-            
-
             int distance = abs(note - candidate);
             if (distance < minDistance || (distance == minDistance && candidate < bestNote)) {
                 minDistance = distance;
@@ -107,27 +158,3 @@ int ScaleManager::getClosestNoteInScale(int note, const std::vector<int>& interv
 
     return bestNote != -1 ? bestNote : note; // fallback
 }
-
-bool ScaleManager::isWhiteKey(int note) {
-    const bool whiteKeys[12] = {
-        // C, C#, D, D#, E, F, F#, G, G#, A, A#, B
-        true, false, true, false, true, true, false, true, false, true, false, true
-    };
-    return whiteKeys[note % 12];
-}
-
-int ScaleManager::getClosestWhiteKey(int note) const {
-    int up = note;
-    int down = note;
-
-    while (up <= 127 || down >= 0) {
-        if (up <= 127 && isWhiteKey(up)) return up;
-        if (down >= 0 && isWhiteKey(down)) return down;
-        ++up;
-        --down;
-    }
-
-    return note; // fallback
-}
-
-
@@ -2,18 +2,57 @@
 #define SCALE_MANAGER_H
 
 #include <Arduino.h>
-#include <vector>
+#include <atomic>
 #include <objects/Settings.h>
 
 struct ScaleDefinition {
     ScaleType type;
     const char* name;
-    std::vector<int> intervals;
+    uint8_t intervals[12];  // Semitones above the root, ascending
+    uint8_t count;
 };
 
+// Scale quantization is a table lookup into tables generated at compile time
+// (ScaleManager.cpp) and stored in flash. Per scale, one table maps the
+// distance of a note from the root to the nearest scale offset, so it serves
+// every root; white-key mode goes through a shared nearest-white-key table
+// first. setScale() is a pointer swap; nothing is built or allocated at run time.
 class ScaleManager {
 public:
-    static const ScaleDefinition _allScales[];
+    // Indexed by ScaleType
+    static constexpr ScaleDefinition _allScales[] = {
+        {ScaleType::CHROMATIC, "Chromatic", {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11}, 12},
+        {ScaleType::MAJOR, "Major", {0, 2, 4, 5, 7, 9, 11}, 7},
+        {ScaleType::MINOR, "Minor", {0, 2, 3, 5, 7, 8, 10}, 7},
+        {ScaleType::HARMONIC_MINOR, "Harmonic Minor", {0, 2, 3, 5, 7, 8, 11}, 7},
+        {ScaleType::MELODIC_MINOR_ASC, "Melodic Minor", {0, 2, 3, 5, 7, 9, 11}, 7},
+        {ScaleType::PENTATONIC_MAJOR, "Pentatonic Major", {0, 2, 4, 7, 9}, 5},
+        {ScaleType::PENTATONIC_MINOR, "Pentatonic Minor", {0, 3, 5, 7, 10}, 5},
+        {ScaleType::BLUES, "Blues Minor", {0, 3, 5, 6, 7, 10}, 6},
+        {ScaleType::DORIAN, "Dorian", {0, 2, 3, 5, 7, 9, 10}, 7},
+        {ScaleType::PHRYGIAN, "Phrygian", {0, 1, 3, 5, 7, 8, 10}, 7},
+        {ScaleType::LYDIAN, "Lydian", {0, 2, 4, 6, 7, 9, 11}, 7},
+        {ScaleType::MIXOLYDIAN, "Mixolydian", {0, 2, 4, 5, 7, 9, 10}, 7},
+        {ScaleType::LOCRIAN, "Locrian", {0, 1, 3, 5, 6, 8, 10}, 7},
+        {ScaleType::PHRYGIAN_DOMINANT, "Phrygian Dominant", {0, 1, 4, 5, 7, 8, 10}, 7},
+        {ScaleType::WHOLE_TONE, "Whole Tone", {0, 2, 4, 6, 8, 10}, 6},
+        {ScaleType::DIMINISHED, "Diminished", {0, 2, 3, 5, 6, 8, 9, 11}, 8},
+        {ScaleType::BLUES_MAJOR, "Blues Major", {0, 2, 3, 4, 7, 9}, 6},
+        {ScaleType::HIRAJOSHI, "Hirajoshi", {0, 2, 3, 7, 8}, 5},
+        {ScaleType::IN_SEN, "In Sen", {0, 1, 5, 7, 10}, 5},
+        {ScaleType::DOUBLE_HARMONIC, "Double Harmonic", {0, 1, 4, 5, 7, 8, 11}, 7},
+        {ScaleType::SUPER_LOCRIAN, "Super Locrian", {0, 1, 3, 4, 6, 8, 10}, 7}
+    };
+    static constexpr int SCALE_COUNT = sizeof(_allScales) / sizeof(_allScales[0]);
+    static constexpr int COMPACT_KEYS = 32;      // White-key positions with a precomputed degree
+    static constexpr int OFFSET_SPAN = 2 * 127 + 1;  // note - root, -127..127
+
+    // Generated per scale (flash)
+    struct ScaleTable {
+        int8_t offset[OFFSET_SPAN];           // note - root + 127 -> nearest scale note - root
+        uint8_t compactOffset[COMPACT_KEYS];  // White-key position -> semitones above root
+    };
+
     ScaleManager(ScaleSettings& settings);
 
     void setScale(ScaleType type);
@@ -28,14 +67,9 @@ public:
 private:
     bool _whiteKeysQuantize; // Default true
     ScaleSettings& _settings;
-    std::vector<int> _currentScaleIntervals;
-
-    void updateScaleIntervals();
-
-    static int getClosestNoteInScale(int note, const std::vector<int>& intervals, int rootNote);
+    std::atomic<const ScaleTable*> _table{nullptr};  // nullptr: unknown scale type
 
-    static bool isWhiteKey(int note);
-    int getClosestWhiteKey(int note) const;
+    static int getClosestNoteInScale(int note, const ScaleDefinition& scale, int rootNote);
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -2,6 +2,7 @@
 #define STRUM_PATTERNS_H
 
 #include <Arduino.h>
+#include <objects/Globals.h>
 
 // Maximum number of notes in a custom ARP pattern (sent via BLE from PatternBuilder)
 #define MAX_PATTERN_LENGTH 16
@@ -31,6 +32,7 @@ inline void setCustomPattern(const int8_t* intervals, uint8_t length) {
     for (uint8_t i = length; i < MAX_PATTERN_LENGTH; i++) {
         customPattern.intervals[i] = 0;
     }
+    chordSettingsChanged();
 }
 
 // Get custom pattern intervals and length
@@ -0,0 +1,71 @@
+#ifndef NATIVE_ADAFRUIT_MCP23X17_H
+#define NATIVE_ADAFRUIT_MCP23X17_H
+
+#include <Arduino.h>
+
+// Simulated MCP23017 for env:native. Inputs idle HIGH (pull-ups); the harness
+// drives them with press()/release(). Every call that would be an I2C
+// transaction on hardware bumps transactionCount() so bus cost can be measured.
+class Adafruit_MCP23X17 {
+public:
+    bool begin_I2C(uint8_t i2c_addr = 0x20, void* wire = nullptr) {
+        (void)wire;
+        _addr = i2c_addr;
+        _transactions++;
+        return true;
+    }
+
+    void pinMode(uint8_t pin, uint8_t mode) {
+        if (pin > 15) return;
+        if (mode == OUTPUT) {
+            _iodir &= ~(1u << pin);
+        } else {
+            _iodir |= (1u << pin);
+        }
+        _transactions += 2;  // read-modify-write of IODIR
+    }
+
+    uint8_t digitalRead(uint8_t pin) {
+        _transactions++;
+        return (pin < 16 && (pinLevels() & (1u << pin))) ? HIGH : LOW;
+    }
+
+    void digitalWrite(uint8_t pin, uint8_t value) {
+        if (pin > 15) return;
+        if (value == LOW) {
+            _olat &= ~(1u << pin);
+        } else {
+            _olat |= (1u << pin);
+        }
+        _transactions += 2;  // read-modify-write of OLAT
+    }
+
+    uint8_t readGPIOA() { _transactions++; return pinLevels() & 0xFF; }
+    uint8_t readGPIOB() { _transactions++; return pinLevels() >> 8; }
+    uint16_t readGPIOAB() { _transactions++; return pinLevels(); }
+
+    void writeGPIOA(uint8_t value) { _olat = (_olat & 0xFF00) | value; _transactions++; }
+    void writeGPIOB(uint8_t value) { _olat = (_olat & 0x00FF) | ((uint16_t)value << 8); _transactions++; }
+    void writeGPIOAB(uint16_t value) { _olat = value; _transactions++; }
+
+    // --- Simulation hooks ---
+    void press(uint8_t pin) { _inputs &= ~(1u << pin); }
+    void release(uint8_t pin) { _inputs |= (1u << pin); }
+    void setInputs(uint16_t levels) { _inputs = levels; }
+    uint16_t outputLatch() const { return _olat; }
+    uint8_t address() const { return _addr; }
+    unsigned long transactionCount() const { return _transactions; }
+    void resetTransactionCount() { _transactions = 0; }
+
+private:
+    // Output pins read back their latch, input pins read the simulated level
+    uint16_t pinLevels() const { return (_inputs & _iodir) | (_olat & ~_iodir); }
+
+    uint8_t _addr = 0x20;
+    uint16_t _iodir = 0xFFFF;
+    uint16_t _olat = 0x0000;
+    uint16_t _inputs = 0xFFFF;
+    unsigned long _transactions = 0;
+};
+
+#endif
@@ -0,0 +1,171 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+// Host-side stand-in for the ESP32 Arduino core (env:native only).
+// Provides just enough of the core API for the control stack to compile on
+// Linux, plus an injectable clock so scans can be stepped deterministically.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define IRAM_ATTR
+
+#define T1 1
+
+using std::max;
+using std::min;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// Simulated time base. millis()/micros() read from here instead of a hardware
+// timer; the native harness advances it between scans.
+struct SimClock {
+    static inline unsigned long nowUs = 0;
+
+    static void set(unsigned long us) { nowUs = us; }
+    static void advanceUs(unsigned long us) { nowUs += us; }
+    static void advanceMs(unsigned long ms) { nowUs += ms * 1000UL; }
+};
+
+inline unsigned long micros() { return SimClock::nowUs; }
+inline unsigned long millis() { return SimClock::nowUs / 1000UL; }
+inline void delay(unsigned long ms) { SimClock::advanceMs(ms); }
+inline void delayMicroseconds(unsigned int us) { SimClock::advanceUs(us); }
+
+// Simulated capacitive touch channels (raw values as returned by touchRead).
+struct SimTouch {
+    static inline uint32_t values[16] = {};
+
+    static void set(uint8_t pin, uint32_t value) { values[pin & 0x0F] = value; }
+};
+
+inline uint32_t touchRead(uint8_t pin) { return SimTouch::values[pin & 0x0F]; }
+
+inline void pinMode(uint8_t, uint8_t) {}
+inline void digitalWrite(uint8_t, uint8_t) {}
+inline int digitalRead(uint8_t) { return HIGH; }
+inline void analogWrite(uint8_t, int) {}
+
+// Same arithmetic as the ESP32 core, including the zero-width input guard
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    const long run = in_max - in_min;
+    if (run == 0) {
+        return -1;
+    }
+    const long rise = out_max - out_min;
+    const long delta = x - in_min;
+    return (delta * rise) / run + out_min;
+}
+
+// Deterministic PRNG so simulated runs are reproducible
+struct SimRandom {
+    static inline uint32_t state = 1;
+};
+
+inline void randomSeed(unsigned long seed) { SimRandom::state = seed ? (uint32_t)seed : 1; }
+inline long random(long howbig) {
+    if (howbig <= 0) return 0;
+    SimRandom::state = SimRandom::state * 1664525UL + 1013904223UL;
+    return (long)((SimRandom::state >> 8) % (uint32_t)howbig);
+}
+inline long random(long howsmall, long howbig) {
+    if (howsmall >= howbig) return howsmall;
+    return random(howbig - howsmall) + howsmall;
+}
+
+class HostSerial {
+public:
+    void begin(unsigned long) {}
+    explicit operator bool() const { return true; }
+
+    void print(const char* s) { fputs(s, stdout); }
+    void print(char c) { fputc(c, stdout); }
+    void print(int v) { printf("%d", v); }
+    void print(unsigned int v) { printf("%u", v); }
+    void print(long v) { printf("%ld", v); }
+    void print(unsigned long v) { printf("%lu", v); }
+    void print(double v) { printf("%.2f", v); }
+
+    template<typename T>
+    void println(T v) { print(v); fputc('\n', stdout); }
+    void println() { fputc('\n', stdout); }
+
+    template<typename... Args>
+    void printf(const char* fmt, Args... args) { ::printf(fmt, args...); }
+};
+
+inline HostSerial Serial;
+
+// Simulated MIDI UART: a TX buffer (plus the 128-byte hardware FIFO) emptied
+// at 1 byte per 320us of SimClock, like the UART TX interrupt on the device.
+// Every byte is logged with the time it was written and the time its stop
+// bit would leave the pin. write() blocks (advances the clock) when full.
+class HardwareSerial {
+public:
+    static constexpr unsigned long US_PER_BYTE = 320;  // 31250 baud, 10 bits
+    static constexpr size_t FIFO_SIZE = 128;
+
+    struct WireByte {
+        unsigned long queuedUs;
+        unsigned long doneUs;
+        uint8_t value;
+    };
+
+    void begin(unsigned long) {}
+    void setTxBufferSize(size_t size) { _txBufferSize = size; }
+
+    int availableForWrite() const {
+        const size_t capacity = FIFO_SIZE + _txBufferSize;
+        const size_t inFlight = bytesInFlight();
+        return inFlight >= capacity ? 0 : (int)(capacity - inFlight);
+    }
+
+    size_t write(uint8_t value) {
+        while (availableForWrite() == 0) {
+            SimClock::advanceUs(US_PER_BYTE);
+        }
+        const unsigned long now = SimClock::nowUs;
+        const unsigned long start = (long)(_wireFreeUs - now) > 0 ? _wireFreeUs : now;
+        _wireFreeUs = start + US_PER_BYTE;
+        _log.push_back({now, _wireFreeUs, value});
+        return 1;
+    }
+
+    size_t write(const uint8_t* data, size_t size) {
+        for (size_t i = 0; i < size; i++) write(data[i]);
+        return size;
+    }
+
+    // --- Simulation hooks ---
+    const std::vector<WireByte>& log() const { return _log; }
+    void clearLog() { _log.clear(); }
+
+private:
+    size_t bytesInFlight() const {
+        if ((long)(_wireFreeUs - SimClock::nowUs) <= 0) return 0;
+        return (_wireFreeUs - SimClock::nowUs + US_PER_BYTE - 1) / US_PER_BYTE;
+    }
+
+    size_t _txBufferSize = 0;
+    unsigned long _wireFreeUs = 0;
+    std::vector<WireByte> _log;
+};
+
+inline HardwareSerial Serial0;
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef NATIVE_MIDI_H
+#define NATIVE_MIDI_H
+
+#include <Arduino.h>
+
+// Stand-in for the FortySevenEffects MIDI library (env:native).
+// Same send* API, serialising each message onto the simulated Serial0 UART
+// (no running status), which logs every byte with its wire time.
+
+#define MIDI_NAMESPACE midi
+
+namespace midi {
+
+typedef uint8_t DataByte;
+typedef uint8_t Channel;
+
+enum MidiType : uint8_t {
+    InvalidType          = 0x00,
+    NoteOff              = 0x80,
+    NoteOn               = 0x90,
+    AfterTouchPoly       = 0xA0,
+    ControlChange        = 0xB0,
+    ProgramChange        = 0xC0,
+    AfterTouchChannel    = 0xD0,
+    PitchBend            = 0xE0,
+    Clock                = 0xF8,
+    Start                = 0xFA,
+    Continue             = 0xFB,
+    Stop                 = 0xFC,
+    ActiveSensing        = 0xFE,
+    SystemReset          = 0xFF,
+};
+
+template<class SerialPort>
+class SerialMIDI {};
+
+template<class Transport>
+class MidiInterface {
+public:
+    explicit MidiInterface(HardwareSerial& port) : _port(port) {}
+
+    void begin(Channel inChannel = 1) {
+        (void)inChannel;
+        _port.begin(31250);
+    }
+    bool read() { return false; }
+
+    void sendNoteOn(DataByte note, DataByte velocity, Channel channel) {
+        send(NoteOn, note, velocity, channel, 3);
+    }
+    void sendNoteOff(DataByte note, DataByte velocity, Channel channel) {
+        send(NoteOff, note, velocity, channel, 3);
+    }
+    void sendControlChange(DataByte number, DataByte value, Channel channel) {
+        send(ControlChange, number, value, channel, 3);
+    }
+    void sendProgramChange(DataByte number, Channel channel) {
+        send(ProgramChange, number, 0, channel, 2);
+    }
+    void sendAfterTouch(DataByte pressure, Channel channel) {
+        send(AfterTouchChannel, pressure, 0, channel, 2);
+    }
+    void sendAfterTouch(DataByte note, DataByte pressure, Channel channel) {
+        send(AfterTouchPoly, note, pressure, channel, 3);
+    }
+    void sendPitchBend(int value, Channel channel) {
+        const unsigned bend = (unsigned)(value + 8192) & 0x3FFF;
+        send(PitchBend, bend & 0x7F, (bend >> 7) & 0x7F, channel, 3);
+    }
+    void sendRealTime(MidiType type) {
+        _port.write((uint8_t)type);
+    }
+
+private:
+    void send(MidiType type, DataByte d1, DataByte d2, Channel channel, unsigned bytes) {
+        const uint8_t msg[3] = {(uint8_t)(type | ((channel - 1) & 0x0F)), (uint8_t)(d1 & 0x7F),
+                                (uint8_t)(d2 & 0x7F)};
+        _port.write(msg, bytes);
+    }
+
+    HardwareSerial& _port;
+};
+
+}  // namespace midi
+
+#define MIDI_CREATE_INSTANCE(Type, SerialPort, Name) \
+    MIDI_NAMESPACE::MidiInterface<MIDI_NAMESPACE::SerialMIDI<Type>> Name(SerialPort);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef NATIVE_SEMPHR_H
+#define NATIVE_SEMPHR_H
+
+#include <freertos/FreeRTOS.h>
+
+// Mutexes always succeed immediately: the harness runs every "task" inline.
+inline SemaphoreHandle_t xSemaphoreCreateMutex() { static int token; return &token; }
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { static int token; return &token; }
+inline void vSemaphoreDelete(SemaphoreHandle_t) {}
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t) { return pdTRUE; }
+
+#endif
@@ -0,0 +1,838 @@
+/*
+ * Host-native harness for the KB1 control stack (env:native).
+ *
+ * Builds KeyboardControl, LeverControls, LeverPushControls, TouchControl,
+ * OctaveControl, ScaleManager and LEDController against the simulated HAL in
+ * src/native/hal, then drives scripted input the way readInputs() and
+ * musicEngineTask() in src/main.cpp do: scans at the adaptive rate, with an
+ * engine pass only when a scan queued an event or at a debounce deadline.
+ * Every byte written to the simulated MIDI UART is logged with its queue and
+ * wire times and decoded back into messages, so scan->MIDI timing can be inspected and compared between
+ * firmware versions without a device.
+ *
+ * Each scenario also checks its output against the expected messages and
+ * invariants, prints "FAIL: ..." for every mismatch and exits non-zero.
+ * "all" runs every scenario except bench, each in a fresh process.
+ *
+ * Usage: program [scale|chord|arp|lever|sustain|flood|strum|pressure|bench|all] [-v]
+ */
+
+#include <Arduino.h>
+#include <Adafruit_MCP23X17.h>
+#include <Preferences.h>
+#include <MIDI.h>
+#include <chrono>
+#include <cstdlib>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include <objects/Constants.h>
+#include <objects/Globals.h>
+#include <objects/Settings.h>
+#include <objects/ScanRateScheduler.h>
+#include <objects/ExpanderBus.h>
+#include <led/LEDController.h>
+#include <music/ScaleManager.h>
+#include <music/StrumPatterns.h>
+#include <midi/MidiLatency.h>
+#include <midi/MidiOutput.h>
+#include <controls/KeyboardControl.h>
+#include <controls/LeverControls.h>
+#include <controls/TouchControl.h>
+#include <controls/LeverPushControls.h>
+#include <controls/OctaveControl.h>
+
+Adafruit_MCP23X17 mcp_U1;
+Adafruit_MCP23X17 mcp_U2;
+ExpanderBus expanderBus(mcp_U1, mcp_U2);
+
+#ifdef SERIAL_PRINT_ENABLED
+bool serialConnected = false;
+#endif
+
+LEDController ledController;
+
+CustomPattern customPattern = {
+    .intervals = {0, 2, 4, 5, 7, 9, 11, 12, 0, 0, 0, 0, 0, 0, 0, 0},
+    .length = 8
+};
+
+unsigned long leverCooldownUntil = 0;
+std::atomic<uint32_t> chordSettingsVersion{0};
+
+void (*syncLever1Callback)() = nullptr;
+void (*syncLeverPush1Callback)() = nullptr;
+void (*syncLever2Callback)() = nullptr;
+void (*syncLeverPush2Callback)() = nullptr;
+void (*notifyChordSettingsCallback)() = nullptr;
+void (*notifyScaleSettingsCallback)() = nullptr;
+void (*resetPatternControlsCallback)() = nullptr;
+
+Preferences preferences;
+BatteryState batteryState = {};
+
+MIDI_CREATE_INSTANCE(HardwareSerial, Serial0, MIDI);
+MidiLatencyStats midiLatency;
+MidiOutput<HardwareSerial> midiOut(Serial0);
+
+// Same defaults as src/main.cpp
+OctaveControl<Adafruit_MCP23X17, LEDController> octaveControl(mcp_U2, ledController);
+
+ScaleSettings scaleSettings = {
+    .scaleType = ScaleType::CHROMATIC,
+    .rootNote = 60,
+    .keyMapping = 0,
+};
+ScaleManager scaleManager(scaleSettings);
+
+ChordSettings chordSettings = {
+    .playMode = PlayMode::SCALE,
+    .chordType = ChordType::MAJOR,
+    .strumEnabled = true,
+    .velocitySpread = 10,
+    .strumSpeed = 110,
+    .strumPattern = 4,
+    .strumSwing = 15,
+    .gateValue = 35,
+    .voicing = 2,
+    .arpUserMode = 0,
+    .arpLatchMode = 1
+};
+
+KeyboardControl<decltype(midiOut), decltype(octaveControl)> keyboardControl(
+    midiOut, octaveControl, scaleManager, chordSettings);
+
+LeverSettings lever1Settings = {
+    .ccNumber = 3,
+    .minCCValue = 0,
+    .maxCCValue = 127,
+    .stepSize = 1,
+    .functionMode = LeverFunctionMode::INTERPOLATED,
+    .valueMode = ValueMode::BIPOLAR,
+    .onsetTime = 100,
+    .offsetTime = 100,
+    .onsetType = InterpolationType::LINEAR,
+    .offsetType = InterpolationType::LINEAR,
+};
+LeverControls<decltype(midiOut)> lever1(
+    BANK_U1, BANK_U2, SWD1_LEFT_PIN, SWD1_RIGHT_PIN, lever1Settings, midiOut,
+    ledController, LedColor::PINK, keyboardControl, chordSettings, scaleManager);
+
+LeverPushSettings leverPush1Settings = {
+    .ccNumber = 209,
+    .minCCValue = 0,
+    .maxCCValue = 127,
+    .functionMode = LeverPushFunctionMode::SUSTAIN,
+    .onsetTime = 500,
+    .offsetTime = 0,
+    .onsetType = InterpolationType::LOGARITHMIC,
+    .offsetType = InterpolationType::LOGARITHMIC,
+};
+LeverPushControls<decltype(midiOut)> leverPush1(
+    BANK_U1, SWD1_CENTER_PIN, leverPush1Settings, lever1, midiOut,
+    ledController, LedColor::PINK, keyboardControl, chordSettings, scaleManager);
+
+LeverSettings lever2Settings = {
+    .ccNumber = 128,
+    .minCCValue = 13,
+    .maxCCValue = 127,
+    .stepSize = 6,
+    .functionMode = LeverFunctionMode::INCREMENTAL,
+    .valueMode = ValueMode::UNIPOLAR,
+    .onsetTime = 100,
+    .offsetTime = 100,
+    .onsetType = InterpolationType::LINEAR,
+    .offsetType = InterpolationType::LINEAR,
+};
+LeverControls<decltype(midiOut)> lever2(
+    BANK_U2, BANK_U2, SWD2_LEFT_PIN, SWD2_RIGHT_PIN, lever2Settings, midiOut,
+    ledController, LedColor::BLUE, keyboardControl, chordSettings, scaleManager);
+
+LeverPushSettings leverPush2Settings = {
+    .ccNumber = 128,
+    .minCCValue = 85,
+    .maxCCValue = 85,
+    .functionMode = LeverPushFunctionMode::RESET,
+    .onsetTime = 100,
+    .offsetTime = 100,
+    .onsetType = InterpolationType::LINEAR,
+    .offsetType = InterpolationType::LINEAR,
+};
+LeverPushControls<decltype(midiOut)> leverPush2(
+    BANK_U2, SWD2_CENTER_PIN, leverPush2Settings, lever2, midiOut,
+    ledController, LedColor::BLUE, keyboardControl, chordSettings, scaleManager);
+
+TouchSettings touchSettings = {
+    .ccNumber = 1,
+    .minCCValue = 38,
+    .maxCCValue = 114,
+    .functionMode = TouchFunctionMode::CONTINUOUS,
+    .threshold = 36800,
+    .offsetTime = 100,
+};
+SystemSettings systemSettings = {
+    .lightSleepTimeout = 300,
+    .deepSleepTimeout = 120,
+    .bleTimeout = 600,
+    .idleConfirmTimeout = 2,
+    .scanLatencyBudgetMs = INPUT_SCAN_IDLE_MS,
+    .touchPressureRateHz = 100,
+    .touchPressureDeadBand = 1,
+    .touchPressureSlew = 2540,
+};
+TouchControl<decltype(midiOut)> touch(
+    T1, touchSettings, 30000, 64000, midiOut, chordSettings, ledController, scaleManager, systemSettings);
+
+// Active scan period on the device; scenarios count time in these units
+// while the actual period follows ScanRateScheduler
+static constexpr unsigned long SCAN_PERIOD_MS = INPUT_SCAN_ACTIVE_MS;
+
+// Key positions for the notes the scenarios play (mirrors KeyboardControl::KEY_MAP)
+struct SimKey {
+    uint8_t midi;
+    ExpanderBank bank;
+    uint8_t pin;
+};
+static const SimKey SIM_KEYS[] = {
+    {60, BANK_U1, 14},  // SW2 (C)
+    {64, BANK_U1, 12},  // SW4 (E)
+    {67, BANK_U1, 10},  // SW6 (G)
+    {72, BANK_U2, 11},  // SW9 (C)
+};
+
+static Adafruit_MCP23X17& expanderFor(ExpanderBank bank) {
+    return bank == BANK_U1 ? mcp_U1 : mcp_U2;
+}
+
+static void pressKey(uint8_t midiNote, bool down) {
+    for (const auto& k : SIM_KEYS) {
+        if (k.midi == midiNote) {
+            if (down) expanderFor(k.bank).press(k.pin);
+            else expanderFor(k.bank).release(k.pin);
+            return;
+        }
+    }
+}
+
+static SpscRing<InputEvent, 32> inputEvents;
+static ScanRateScheduler scanRate;
+
+// One readInputs() pass: sample, stamp and queue (GPIO only when changed);
+// returns whether it queued anything (which wakes musicEngineTask), and in
+// gpioChanged whether a pin changed
+static bool scanInputs(bool& gpioChanged) {
+    bool pushed = false;
+    static GPIOCache lastSent = {0xFFFF, 0xFFFF, 0};
+    static bool gpioPending = true;
+    static unsigned long lastTouchUs = micros() - TOUCH_SAMPLE_MS * 1000UL;
+    if (micros() - lastTouchUs >= TOUCH_SAMPLE_MS * 1000UL - 500) {
+        lastTouchUs = micros();
+        pushed |= inputEvents.push({InputEvent::TOUCH_SAMPLE, 0, 0, (uint32_t)touch.sample(), lastTouchUs});
+    }
+
+    const GPIOCache gpioCache = expanderBus.read();
+    gpioChanged = (gpioCache.u1_pins ^ lastSent.u1_pins) | (gpioCache.u2_pins ^ lastSent.u2_pins);
+    if (gpioPending || gpioChanged) {
+        gpioPending = !inputEvents.push(
+            {InputEvent::GPIO_SNAPSHOT, gpioCache.u1_pins, gpioCache.u2_pins, 0, gpioCache.timestamp});
+        pushed |= !gpioPending;
+        lastSent = gpioCache;
+    }
+    expanderBus.flush();
+    return pushed;
+}
+
+static void applyGpioSnapshot(const GPIOCache& gpioCache) {
+    lever1.update(gpioCache);
+    lever2.update(gpioCache);
+    leverPush1.update(gpioCache);
+    leverPush2.update(gpioCache);
+    octaveControl.update(gpioCache);
+    keyboardControl.updateKeyboardState(gpioCache);
+}
+
+// musicEngineTask's timed wait: when armed, it wakes at engineWakeUs even
+// without an event (next key debounce deadline)
+static bool engineWakeArmed = false;
+static unsigned long engineWakeUs = 0;
+
+// One musicEngineTask() pass, minus BLE, LED targets and sleep logic
+static void runEngine() {
+    static GPIOCache gpioCache = {0xFFFF, 0xFFFF, 0};
+    bool gpioApplied = false;
+    InputEvent ev;
+    while (inputEvents.pop(ev)) {
+        if (ev.type == InputEvent::TOUCH_SAMPLE) {
+            touch.update((int)ev.touchRaw);
+        } else {
+            gpioCache = ev.gpio();
+            applyGpioSnapshot(gpioCache);
+            gpioApplied = true;
+        }
+    }
+    if (!gpioApplied) {
+        gpioCache.timestamp = micros();
+        applyGpioSnapshot(gpioCache);
+    }
+
+    midiOut.service();
+    ledController.update();
+
+    const long debounceMs = keyboardControl.debounceWaitMs();
+    engineWakeArmed = debounceMs >= 0;
+    engineWakeUs = micros() + (debounceMs > 0 ? debounceMs : 1) * 1000UL;
+}
+
+// One scan, and an engine pass if the scan queued an event or the engine's
+// timed wait is up; returns the period until the next scan
+static unsigned long scanOnce() {
+    bool gpioChanged = false;
+    if (scanInputs(gpioChanged) || (engineWakeArmed && (long)(micros() - engineWakeUs) >= 0)) {
+        runEngine();
+    }
+
+    const unsigned long nowMs = millis();
+    if (gpioChanged) scanRate.onEdge(nowMs);
+    if (touch.isActive() || keyboardControl.anyKeyActive() || keyboardControl.isArpActive()) {
+        scanRate.onActivity(nowMs);
+    }
+    return scanRate.nextPeriodMs(nowMs);
+}
+
+// seqClockTask: between scans, wake at each scheduled event's exact time
+static void runSequencerClock(unsigned long untilUs) {
+    unsigned long dueUs;
+    while (keyboardControl.nextEventDueUs(dueUs) && (long)(dueUs - untilUs) < 0) {
+        if ((long)(dueUs - micros()) > 0) SimClock::set(dueUs);
+        keyboardControl.runScheduler();
+    }
+    SimClock::set(untilUs);
+}
+
+// Run count active-rate scan periods of simulated time, scanning at the
+// adaptive rate; returns the number of scans taken
+static unsigned long runScans(int count) {
+    const unsigned long endUs = micros() + count * SCAN_PERIOD_MS * 1000UL;
+    unsigned long scans = 0;
+    while ((long)(endUs - micros()) > 0) {
+        unsigned long nextUs = micros() + scanOnce() * 1000UL;
+        if ((long)(nextUs - endUs) > 0) nextUs = endUs;
+        // Debounce deadlines between scans wake the engine on their own
+        while (engineWakeArmed && (long)(engineWakeUs - nextUs) < 0) {
+            if ((long)(engineWakeUs - micros()) > 0) runSequencerClock(engineWakeUs);
+            runEngine();
+        }
+        runSequencerClock(nextUs);
+        scans++;
+    }
+    return scans;
+}
+
+static const char* typeName(uint8_t type) {
+    switch (type) {
+        case midi::NoteOn: return "NoteOn";
+        case midi::NoteOff: return "NoteOff";
+        case midi::ControlChange: return "CC";
+        case midi::AfterTouchChannel: return "ChPress";
+        case midi::PitchBend: return "PB";
+        default: return "Other";
+    }
+}
+
+// A channel message reassembled from the Serial0 byte log
+struct WireMessage {
+    unsigned long queuedUs;  // first byte handed to the UART
+    unsigned long wireUs;    // last byte on the wire
+    uint8_t type;
+    uint8_t channel;
+    uint8_t data1;
+    uint8_t data2;
+    uint8_t bytes;           // bytes on the wire (status omitted under running status)
+};
+
+static std::vector<WireMessage> decodeMidi() {
+    std::vector<WireMessage> out;
+    uint8_t status = 0;
+    uint8_t data[2];
+    int have = 0;
+    bool statusSent = false;
+    unsigned long firstUs = 0;
+    for (const auto& b : Serial0.log()) {
+        if (b.value & 0x80) {
+            status = b.value;
+            statusSent = true;
+            have = 0;
+            firstUs = b.queuedUs;
+            continue;
+        }
+        if (status == 0) continue;
+        if (have == 0 && !statusSent) firstUs = b.queuedUs;  // Running status
+        data[have++] = b.value;
+        const int needed = ((status & 0xF0) == 0xC0 || (status & 0xF0) == 0xD0) ? 1 : 2;
+        if (have == needed) {
+            uint8_t type = status & 0xF0;
+            if (type == midi::NoteOn && data[1] == 0) type = midi::NoteOff;  // Velocity-0 NoteOn
+            out.push_back({firstUs, b.doneUs, type, (uint8_t)((status & 0x0F) + 1), data[0],
+                           needed == 2 ? data[1] : (uint8_t)0, (uint8_t)(needed + (statusSent ? 1 : 0))});
+            have = 0;
+            statusSent = false;
+        }
+    }
+    return out;
+}
+
+static void clearMidi() { Serial0.clearLog(); }
+
+// DIN bandwidth actually used (running status makes this < 3 bytes/message)
+static void reportWireBytes() {
+    printf("%zu messages, %zu bytes on wire\n", decodeMidi().size(), Serial0.log().size());
+}
+
+static size_t countMidi(uint8_t type) {
+    size_t n = 0;
+    for (const auto& m : decodeMidi()) {
+        if (m.type == type) n++;
+    }
+    return n;
+}
+
+static void dumpMidi(unsigned long originUs) {
+    for (const auto& m : decodeMidi()) {
+        printf("%9.3f ms  %-8s ch%-2u %3u %3u  (wire +%lu us)\n",
+               ((long)m.queuedUs - (long)originUs) / 1000.0, typeName(m.type), m.channel,
+               m.data1, m.data2, m.wireUs - m.queuedUs);
+    }
+}
+
+// Press edge -> first NoteOn (debounce + scan quantisation + wire time)
+static void reportFirstNoteLatency(unsigned long pressUs) {
+    for (const auto& m : decodeMidi()) {
+        if (m.type == midi::NoteOn) {
+            printf("press->NoteOn sent: %.3f ms, on wire: %.3f ms\n",
+                   (m.queuedUs - pressUs) / 1000.0, (m.wireUs - pressUs) / 1000.0);
+            return;
+        }
+    }
+    printf("press->NoteOn: no NoteOn recorded\n");
+}
+
+// ---- Checks ----
+
+static int checks = 0;
+static int failures = 0;
+
+static bool expect(bool ok, const char* what) {
+    checks++;
+    if (!ok) {
+        printf("FAIL: %s\n", what);
+        failures++;
+    }
+    return ok;
+}
+
+struct NoteMsg {
+    uint8_t type;
+    uint8_t note;
+    uint8_t velocity;
+};
+
+static NoteMsg on(uint8_t note, uint8_t velocity) { return {midi::NoteOn, note, velocity}; }
+static NoteMsg off(uint8_t note) { return {midi::NoteOff, note, 0}; }
+
+static std::vector<WireMessage> notesOnWire() {
+    std::vector<WireMessage> notes;
+    for (const auto& m : decodeMidi()) {
+        if (m.type == midi::NoteOn || m.type == midi::NoteOff) notes.push_back(m);
+    }
+    return notes;
+}
+
+// Exact NoteOn/NoteOff sequence on the wire (other messages ignored)
+static void expectNotes(std::initializer_list<NoteMsg> expected) {
+    const auto notes = notesOnWire();
+    size_t i = 0;
+    for (const NoteMsg& e : expected) {
+        char what[96];
+        if (i >= notes.size()) {
+            snprintf(what, sizeof(what), "note message %zu: expected %s %u, got nothing", i, typeName(e.type), e.note);
+            expect(false, what);
+            return;
+        }
+        const WireMessage& m = notes[i];
+        snprintf(what, sizeof(what), "note message %zu: expected %s %u/%u, got %s %u/%u", i, typeName(e.type),
+                 e.note, e.velocity, typeName(m.type), m.data1, m.data2);
+        if (!expect(m.type == e.type && m.data1 == e.note && m.data2 == e.velocity, what)) return;
+        i++;
+    }
+    char what[64];
+    snprintf(what, sizeof(what), "%zu note messages, expected %zu", notes.size(), expected.size());
+    expect(notes.size() == expected.size(), what);
+}
+
+// No NoteOn for a note already sounding, no NoteOff for a silent one and,
+// unless sounding is allowed (latched arp), nothing left on at the end
+static void expectBalancedNotes(bool allowSounding = false) {
+    uint8_t sounding[128] = {};
+    bool duplicateOn = false, strayOff = false;
+    for (const auto& m : notesOnWire()) {
+        if (m.type == midi::NoteOn) {
+            duplicateOn |= sounding[m.data1] != 0;
+            sounding[m.data1] = 1;
+        } else {
+            strayOff |= sounding[m.data1] == 0;
+            sounding[m.data1] = 0;
+        }
+    }
+    int left = 0;
+    for (const auto n : sounding) left += n;
+    expect(!duplicateOn, "NoteOn for a note already sounding");
+    expect(!strayOff, "NoteOff for a note not sounding");
+    if (!allowSounding) expect(left == 0, "notes still sounding at the end");
+}
+
+// Press edge -> first NoteOn queued within the debounce window plus one scan
+static void expectFirstNoteWithinDebounce(unsigned long pressUs) {
+    for (const auto& m : decodeMidi()) {
+        if (m.type != midi::NoteOn) continue;
+        expect(m.queuedUs - pressUs <=
+                   (decltype(keyboardControl)::KEY_PRESS_DEBOUNCE_MS + INPUT_SCAN_ACTIVE_MS) * 1000UL,
+               "first NoteOn later than debounce + one scan");
+        return;
+    }
+    expect(false, "no NoteOn recorded");
+}
+
+// Last value of controller number on channel 1 (-1 if never sent)
+static int lastControlValue(uint8_t number) {
+    int value = -1;
+    for (const auto& m : decodeMidi()) {
+        if (m.type == midi::ControlChange && m.data1 == number) value = m.data2;
+    }
+    return value;
+}
+
+static void scenarioTap(PlayMode mode, int holdScans) {
+    chordSettings.playMode = mode;
+    runScans(2);
+    clearMidi();
+    const unsigned long pressUs = micros() + 1200;  // land mid-period, like a real finger
+    SimClock::advanceUs(1200);
+    pressKey(60, true);
+    runScans(holdScans);
+    pressKey(60, false);
+    runScans(40);
+    dumpMidi(pressUs);
+    reportWireBytes();
+    reportFirstNoteLatency(pressUs);
+
+    char buf[128];
+    midiLatency.format(buf, sizeof(buf));
+    printf("%s\n", buf);
+
+    expectFirstNoteWithinDebounce(pressUs);
+    switch (mode) {
+        case PlayMode::SCALE:
+            expectNotes({on(60, 85), off(60)});
+            expect(midiLatency.events() == 1, "one latency sample per key press");
+            break;
+        case PlayMode::CHORD:
+            // Major, 2 octaves, strummed with staccato steps; release stops
+            // only the notes still held (root and last)
+            expectNotes({on(60, 85), on(64, 80), off(64), on(67, 76), off(67), on(72, 72), off(72),
+                         on(76, 69), off(76), on(79, 65), off(60), off(79)});
+            expectBalancedNotes();
+            break;
+        default:
+            // Contract order, latched: keeps cycling after the key is released
+            expectNotes({on(60, 85), off(60), on(79, 65), off(79), on(64, 80), off(64), on(76, 69), off(76),
+                         on(67, 76), off(67), on(72, 72), off(72), on(60, 85), off(60), on(79, 65), off(79),
+                         on(64, 80), off(64), on(76, 69), off(76), on(67, 76)});
+            expectBalancedNotes(true);
+            break;
+    }
+}
+
+static void scenarioLever() {
+    clearMidi();
+    const unsigned long startUs = micros();
+    mcp_U2.press(SWD1_RIGHT_PIN);
+    runScans(30);
+    mcp_U2.release(SWD1_RIGHT_PIN);
+    runScans(30);
+    dumpMidi(startUs);
+    printf("CC messages: %zu over %d scans\n", countMidi(midi::ControlChange), 60);
+    reportWireBytes();
+
+    // Bipolar ramp: up to the maximum, then back to the centre, one way at a time
+    int peak = -1, last = -1;
+    bool rising = true, monotonic = true;
+    for (const auto& m : decodeMidi()) {
+        if (m.type != midi::ControlChange || m.data1 != lever1Settings.ccNumber) continue;
+        if (last >= 0) {
+            if (rising && m.data2 < last) rising = false;
+            else if (!rising && m.data2 > last) monotonic = false;
+        }
+        if (m.data2 > peak) peak = m.data2;
+        last = m.data2;
+    }
+    expect(monotonic, "lever CC ramp changed direction twice");
+    expect(peak == lever1Settings.maxCCValue, "lever CC ramp did not reach the maximum");
+    expect(last == (lever1Settings.minCCValue + lever1Settings.maxCCValue) / 2,
+           "lever CC did not return to the centre");
+    expect(countMidi(midi::NoteOn) + countMidi(midi::NoteOff) == 0, "lever sent notes");
+}
+
+// Sustain (lever push 1, momentary, 500ms tail): each released key's NoteOff
+// is deferred through the keyboard's event scheduler
+static void scenarioSustain() {
+    chordSettings.playMode = PlayMode::SCALE;
+    clearMidi();
+    const unsigned long startUs = micros();
+    mcp_U1.press(SWD1_CENTER_PIN);
+    runScans(4);
+    for (uint8_t note : {60, 64, 67}) {
+        pressKey(note, true);
+        runScans(10);
+        pressKey(note, false);
+        runScans(10);
+    }
+    mcp_U1.release(SWD1_CENTER_PIN);
+    runScans(120);
+    dumpMidi(startUs);
+
+    char buf[64];
+    keyboardControl.scheduler().format(buf, sizeof(buf));
+    printf("%s\n", buf);
+
+    expectNotes({on(60, 85), on(64, 85), on(67, 85), off(60), off(64), off(67)});
+    expectBalancedNotes();
+    // Each NoteOff waits for the sustain tail after its key's release
+    const auto notes = notesOnWire();
+    if (notes.size() == 6) {
+        for (int i = 0; i < 3; i++) {
+            expect(notes[i + 3].queuedUs - notes[i].queuedUs >= leverPush1Settings.onsetTime * 1000UL,
+                   "sustained NoteOff earlier than the tail");
+        }
+    }
+    expect(keyboardControl.scheduler().overflows() == 0, "scheduler overflowed");
+}
+
+// Saturated link: a BLE editor floods more controllers than the continuous
+// lane has slots (and more than 31.25 kbaud can carry) while a lever ramps and
+// a chord is played. Notes must keep their timing; the continuous lane thins
+// out instead, but every controller still ends at its last value.
+static constexpr uint8_t FLOOD_FIRST_CC = 20;
+static constexpr uint8_t FLOOD_CCS = decltype(midiOut)::CC_SLOTS + 4;
+
+static void scenarioFlood() {
+    chordSettings.playMode = PlayMode::CHORD;
+    clearMidi();
+    mcp_U2.press(SWD1_RIGHT_PIN);
+    unsigned long pressUs = 0;
+    for (int scan = 0; scan < 120; scan++) {
+        for (uint8_t cc = FLOOD_FIRST_CC; cc < FLOOD_FIRST_CC + FLOOD_CCS; cc++) {
+            midiOut.postControlChange(cc, (uint8_t)((scan + cc) & 0x7F), 1);
+        }
+        if (scan == 40) {
+            SimClock::advanceUs(1200);
+            pressUs = micros();
+            pressKey(60, true);
+        }
+        if (scan == 80) pressKey(60, false);
+        runScans(1);
+    }
+    mcp_U2.release(SWD1_RIGHT_PIN);
+    runScans(40);
+    printf("CC messages: %zu, notes: %zu\n", countMidi(midi::ControlChange),
+           countMidi(midi::NoteOn) + countMidi(midi::NoteOff));
+    reportWireBytes();
+    reportFirstNoteLatency(pressUs);
+    printf("lost CC updates: %lu, merged: %lu, dropped: %lu\n", (unsigned long)midiOut.lostUpdates(),
+           (unsigned long)midiOut.coalescedMessages(), (unsigned long)midiOut.droppedMessages());
+
+    // Notes keep their timing: never queued behind the flood
+    for (const auto& m : decodeMidi()) {
+        if (m.type != midi::NoteOn) continue;
+        expect(m.wireUs - pressUs <=
+                   (decltype(keyboardControl)::KEY_PRESS_DEBOUNCE_MS + 2 * INPUT_SCAN_ACTIVE_MS) * 1000UL,
+               "first NoteOn delayed by the CC flood");
+        break;
+    }
+    expectBalancedNotes();
+    expect(midiOut.droppedMessages() == 0, "messages dropped");
+    // Thinned, but the latest value of every controller reaches the wire
+    for (uint8_t cc = FLOOD_FIRST_CC; cc < FLOOD_FIRST_CC + FLOOD_CCS; cc++) {
+        char what[48];
+        snprintf(what, sizeof(what), "CC %u did not end at its last value", cc);
+        expect(lastControlValue(cc) == ((119 + cc) & 0x7F), what);
+    }
+    expect(lastControlValue(lever1Settings.ccNumber) ==
+               (lever1Settings.minCCValue + lever1Settings.maxCCValue) / 2,
+           "lever CC did not return to the centre");
+}
+
+// Fast chord change: a second strum starts while the first is still
+// cascading. Both cascades must run to the end on their own voices.
+static void scenarioStrum() {
+    chordSettings.playMode = PlayMode::CHORD;
+    runScans(2);
+    clearMidi();
+    const unsigned long startUs = micros();
+    pressKey(60, true);
+    runScans(30);
+    pressKey(67, true);
+    runScans(200);
+    pressKey(60, false);
+    pressKey(67, false);
+    runScans(40);
+    dumpMidi(startUs);
+    printf("NoteOn messages: %zu\n", countMidi(midi::NoteOn));
+    reportWireBytes();
+
+    // C and G major strums overlap. G (67) and the shared upper G (79)
+    // ring on through the other voice's steps instead of being retriggered
+    // or cut.
+    expectNotes({on(60, 85), on(64, 80), on(67, 85), off(64), on(71, 80), on(72, 72), off(71), on(74, 76),
+                 off(72), on(76, 69), off(74), on(79, 72), off(76), on(83, 69), off(83), on(86, 65),
+                 off(60), off(79), off(67), off(86)});
+    expectBalancedNotes();
+}
+
+// Touch pad in AFTERTOUCH mode: press over 100ms, hold with sensor jitter,
+// release. Pressure must stay within the rate limit and end at 0.
+static void scenarioPressure() {
+    touchSettings.functionMode = TouchFunctionMode::AFTERTOUCH;
+    runScans(2);
+    clearMidi();
+    const unsigned long startUs = micros();
+    for (int scan = 0; scan < 20; scan++) {
+        SimTouch::set(T1, 32000 + scan * 1400);
+        runScans(1);
+    }
+    for (int scan = 0; scan < 60; scan++) {
+        SimTouch::set(T1, 60000 + ((scan * 7919) % 400) - 200);
+        runScans(1);
+    }
+    SimTouch::set(T1, 32000);
+    runScans(60);
+    dumpMidi(startUs);
+    printf("ChPress messages: %zu over %d scans\n", countMidi(midi::AfterTouchChannel), 140);
+    reportWireBytes();
+
+    // Rate-limited, jitter inside the dead band is not sent, ends at 0
+    int last = -1;
+    unsigned long lastUs = 0;
+    bool withinRate = true;
+    for (const auto& m : decodeMidi()) {
+        if (m.type != midi::AfterTouchChannel) continue;
+        if (last >= 0 && m.queuedUs - lastUs < 1000000UL / systemSettings.touchPressureRateHz) withinRate = false;
+        last = m.data1;
+        lastUs = m.queuedUs;
+    }
+    expect(withinRate, "channel pressure faster than touchPressureRateHz");
+    expect(last == 0, "channel pressure did not return to 0");
+    expect(countMidi(midi::AfterTouchChannel) <= 20, "sensor jitter sent as pressure");
+}
+
+// Host throughput of the idle scan path, plus simulated I2C cost per scan
+static void scenarioBench() {
+    constexpr int PERIODS = 200000;
+    runScans(400);  // Past INPUT_SETTLE_MS, so the scan rate idles
+    mcp_U1.resetTransactionCount();
+    mcp_U2.resetTransactionCount();
+    auto t0 = std::chrono::steady_clock::now();
+    const unsigned long scans = runScans(PERIODS);
+    auto t1 = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / scans;
+    printf("idle scan: %.1f ns/scan (host), %.2f I2C transactions/scan, %lu scans in %lus\n", ns,
+           (double)(mcp_U1.transactionCount() + mcp_U2.transactionCount()) / scans, scans,
+           PERIODS * SCAN_PERIOD_MS / 1000);
+    char buf[96];
+    scanRate.format(buf, sizeof(buf));
+    printf("%s\n", buf);
+
+    // One combined read per expander per scan, no LED writes while idle
+    expect(mcp_U1.transactionCount() + mcp_U2.transactionCount() <= 2 * scans, "more than 2 I2C transactions per idle scan");
+}
+
+int main(int argc, char** argv) {
+    const char* scenario = "scale";
+    bool verbose = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            verbose = true;
+#ifdef SERIAL_PRINT_ENABLED
+            serialConnected = true;
+#endif
+        } else {
+            scenario = argv[i];
+        }
+    }
+
+    if (strcmp(scenario, "all") == 0) {
+        // Fresh process per scenario: they all start from boot state
+        int failed = 0;
+        for (const char* name : {"scale", "chord", "arp", "lever", "sustain", "flood", "strum", "pressure"}) {
+            printf("=== %s\n", name);
+            fflush(stdout);
+            const std::string cmd = std::string("\"") + argv[0] + "\" " + name + (verbose ? " -v" : "");
+            if (std::system(cmd.c_str()) != 0) failed++;
+        }
+        printf("%d scenario(s) failed\n", failed);
+        return failed ? 1 : 0;
+    }
+
+    mcp_U1.begin_I2C(0x20);
+    mcp_U2.begin_I2C(0x21);
+    mcp_U1.pinMode(SWD1_LEFT_PIN, INPUT_PULLUP);
+    mcp_U1.pinMode(SWD1_CENTER_PIN, INPUT_PULLUP);
+    mcp_U2.pinMode(SWD1_RIGHT_PIN, INPUT_PULLUP);
+    mcp_U2.pinMode(SWD2_LEFT_PIN, INPUT_PULLUP);
+    mcp_U2.pinMode(SWD2_CENTER_PIN, INPUT_PULLUP);
+    mcp_U2.pinMode(SWD2_RIGHT_PIN, INPUT_PULLUP);
+    SimTouch::set(T1, 32000);  // untouched pad, below threshold
+
+    SimClock::set(1000000UL);  // start at 1 s so "0 = never" timestamps stay distinct
+    Serial0.setTxBufferSize(MIDI_UART_TX_BUFFER);
+    MIDI.begin(1);
+    for (int ch = 1; ch <= 16; ch++) {
+        midiOut.sendControlChange(121, 0, ch);
+        midiOut.sendControlChange(123, 0, ch);
+    }
+    midiOut.flush();
+    keyboardControl.begin();
+    octaveControl.begin();
+    ledController.begin(LedColor::OCTAVE_UP, 7, &expanderBus, BANK_U2);
+    ledController.begin(LedColor::OCTAVE_DOWN, 5, &expanderBus, BANK_U2);
+    ledController.begin(LedColor::BLUE, 7);
+    ledController.begin(LedColor::PINK, 8);
+
+    // Let the boot-time panic NoteOffs drain off the simulated wire
+    runScans(100);
+    clearMidi();
+
+    if (strcmp(scenario, "scale") == 0) {
+        scenarioTap(PlayMode::SCALE, 20);
+    } else if (strcmp(scenario, "chord") == 0) {
+        scenarioTap(PlayMode::CHORD, 120);
+    } else if (strcmp(scenario, "arp") == 0) {
+        scenarioTap(PlayMode::ARP, 200);
+    } else if (strcmp(scenario, "lever") == 0) {
+        scenarioLever();
+    } else if (strcmp(scenario, "sustain") == 0) {
+        scenarioSustain();
+    } else if (strcmp(scenario, "flood") == 0) {
+        scenarioFlood();
+    } else if (strcmp(scenario, "strum") == 0) {
+        scenarioStrum();
+    } else if (strcmp(scenario, "pressure") == 0) {
+        scenarioPressure();
+    } else if (strcmp(scenario, "bench") == 0) {
+        scenarioBench();
+    } else {
+        printf("unknown scenario '%s' (scale|chord|arp|lever|sustain|flood|strum|pressure|bench|all)\n", scenario);
+        return 1;
+    }
+    printf("%s: %d/%d checks passed\n", scenario, checks - failures, checks);
+    return failures ? 1 : 0;
+}
@@ -20,6 +20,25 @@
 #define SWD2_CENTER_PIN 2 // SWD2 Center button pin
 #define SWD2_RIGHT_PIN 3  // SWD2 Right button pin
 
+// MIDI UART (Serial0) TX buffer in bytes, drained by the UART TX interrupt.
+// MidiOutput never writes more than this has room for, so sends never block.
+#define MIDI_UART_TX_BUFFER 256
+
+// MCP23017 interrupt-on-change line: INTA/INTB of both expanders (mirrored,
+// open-drain) wired-OR onto one ESP32 GPIO. -1 = not wired, readInputs polls.
+// When wired, a pin change also wakes readInputs at once.
+#define MCP_INT_PIN -1
+
+// Adaptive scan rate (ScanRateScheduler): BURST for INPUT_BURST_HOLD_MS after
+// any pin edge, ACTIVE while inputs are in use and INPUT_SETTLE_MS after,
+// IDLE otherwise. Every period is capped by SystemSettings::scanLatencyBudgetMs.
+#define INPUT_SCAN_BURST_MS 1
+#define INPUT_SCAN_ACTIVE_MS 5
+#define INPUT_SCAN_IDLE_MS 20    // Still polls touch, lever ramps, sleep timers
+#define INPUT_BURST_HOLD_MS 40   // Covers both debounce windows plus bounce
+#define INPUT_SETTLE_MS 1000
+#define TOUCH_SAMPLE_MS INPUT_SCAN_ACTIVE_MS  // Shortest touch sample interval (smoothing is per sample)
+
 #define SERVICE_UUID             "f22b99e8-81ab-4e46-abff-79a74a1f2ff3"
 #define LEVER1_SETTINGS_UUID     "6bae0d4d-a0a4-4bc6-9802-a5d27fb15680"
 #define LEVERPUSH1_SETTINGS_UUID "1de84ff3-36c0-4cf6-912b-208600cf94f4"
@@ -50,6 +69,9 @@
 // Battery Control UUID (write - for commands like reset/recalibrate)
 #define BATTERY_CONTROL_UUID     "a1b2c3d4-5e6f-7a8b-9c0d-1e2f3a4b5c6e"
 
+// Performance Stats UUID (read = scan->MIDI latency p50/p99/max, write 0x01 = reset)
+#define PERF_STATS_UUID          "a1b2c3d4-5e6f-7a8b-9c0d-1e2f3a4b5c70"
+
 // Battery monitoring constants
 #define BATTERY_CAPACITY_MAH 420          // Battery capacity in mAh
 #define BATTERY_CHARGE_CURRENT_MA 100     // Charging current in mA
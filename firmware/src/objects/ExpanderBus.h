@@ -0,0 +1,78 @@
+#ifndef EXPANDER_BUS_H
+#define EXPANDER_BUS_H
+
+#include <Arduino.h>
+#include <atomic>
+#include <Adafruit_MCP23X17.h>
+#include <objects/Globals.h>
+
+// Single owner of the I2C bus to both MCP23017s. Once the tasks run, only
+// the owner (readInputs) calls read() and flush(); everyone else posts
+// output levels, which is lock-free and never touches the bus. This replaces
+// the I2C mutex that readInputs and ledTask used to contend on.
+//
+// Each owner cycle is one combined read (readGPIOAB per expander) and, for
+// an expander with posted changes, one writeGPIOAB of its whole output latch.
+// OLAT bits of input pins are ignored by the chip, so the word can be
+// written as a whole.
+//
+// Levels are kept in a shadow of both output latches, one 32-bit word laid
+// out like GPIOCache::lowMask() (U1 in bits 0-15, U2 in bits 16-31), latest
+// post wins. A post that does not change its bit leaves nothing to write,
+// so LEDs refreshed every millisecond cost no bus traffic in steady state;
+// one that does wakes the owner so the change lands at once.
+class ExpanderBus {
+public:
+    ExpanderBus(Adafruit_MCP23X17& u1, Adafruit_MCP23X17& u2) : _chips{&u1, &u2} {}
+
+    // Called (from the posting task) when a post leaves a latch to write
+    void setOwnerWake(void (*wake)()) { _wake = wake; }
+
+    // Setup only, before the owner task starts: make pin an output at level
+    void configureOutput(ExpanderBank bank, uint8_t pin, bool level) {
+        post(bank, pin, level);
+        _pending.fetch_or(1UL << expanderBit(bank, pin), std::memory_order_relaxed);  // Chip latch unknown
+        flush();
+        _chips[bank]->pinMode(pin, OUTPUT);
+    }
+
+    // Any task: request an output level, written by the owner's next flush()
+    void post(ExpanderBank bank, uint8_t pin, bool level) {
+        const uint32_t bit = 1UL << expanderBit(bank, pin);
+        const uint32_t old = level ? _olat.fetch_or(bit, std::memory_order_relaxed)
+                                   : _olat.fetch_and(~bit, std::memory_order_relaxed);
+        if (((old & bit) != 0) == level) return;  // Latch already holds it
+        _pending.fetch_or(bit, std::memory_order_release);
+        if (_wake) _wake();
+    }
+
+    // Owner: both input banks, stamped
+    GPIOCache read() {
+        GPIOCache cache;
+        cache.u1_pins = _chips[BANK_U1]->readGPIOAB();
+        cache.u2_pins = _chips[BANK_U2]->readGPIOAB();
+        cache.timestamp = micros();
+        return cache;
+    }
+
+    // Owner: one latch write per expander with changed bits
+    void flush() {
+        const uint32_t pending = _pending.exchange(0, std::memory_order_acquire);
+        if (pending == 0) return;
+        const uint32_t olat = _olat.load(std::memory_order_relaxed);
+        if (pending & 0xFFFF) _chips[BANK_U1]->writeGPIOAB((uint16_t)olat);
+        if (pending >> 16) _chips[BANK_U2]->writeGPIOAB((uint16_t)(olat >> 16));
+        _writes += ((pending & 0xFFFF) != 0) + ((pending >> 16) != 0);
+    }
+
+    uint32_t writes() const { return _writes; }  // Latch writes so far (owner's count)
+
+private:
+    Adafruit_MCP23X17* _chips[2];
+    std::atomic<uint32_t> _olat{0};
+    std::atomic<uint32_t> _pending{0};
+    void (*_wake)() = nullptr;
+    uint32_t _writes = 0;
+};
+
+#endif
@@ -2,45 +2,43 @@
 #define GLOBALS_H
 
 #include <Arduino.h>
+#include <atomic>
 #include <Adafruit_MCP23X17.h>
 #include <Preferences.h>
 #include <MIDI.h>
 #include <objects/Constants.h>
+#include <midi/MidiOutput.h>
 
 extern Adafruit_MCP23X17 mcp_U1;
 extern Adafruit_MCP23X17 mcp_U2;
 
-struct key {
-    uint8_t midi;
-    uint8_t pin;
-    bool state;
-    bool prevState;
-    Adafruit_MCP23X17 *mcp;
-    char name[12];
-
-    // Constructor to allow initialization
-    key(uint8_t m, uint8_t p, bool s, bool ps, Adafruit_MCP23X17 *_mcp, const char* n)
-        : midi(m), pin(p), state(s), prevState(false), mcp(_mcp)
-    {
-        strncpy(name, n, sizeof(name) - 1);
-        name[sizeof(name) - 1] = '\0'; // Ensure null-termination
-        lastReading = s;
-        debouncedState = s;
-        lastDebounceTime = 0;
-    }
+// Which MCP23017 a pin lives on. Keys and GPIOCache lookups use this index
+// instead of comparing expander pointers, so the key map does not depend on
+// the mcp_U1/mcp_U2 globals (lets the native build swap in simulated chips).
+enum ExpanderBank : uint8_t {
+    BANK_U1 = 0,
+    BANK_U2 = 1
+};
 
-    // Default constructor needed for array initialization
-    key() : midi(0), pin(0), state(false), prevState(false), mcp(nullptr) {
-        name[0] = '\0';
-        lastReading = false;
-        debouncedState = false;
-        lastDebounceTime = 0;
-    }
-    
-    // Debounce/state tracking
-    bool lastReading;
-    bool debouncedState;
-    unsigned long lastDebounceTime;
+// Position of an expander pin in the 32-bit scan word (GPIOCache::lowMask())
+constexpr uint8_t expanderBit(ExpanderBank bank, uint8_t pin) {
+    return bank * 16 + pin;
+}
+
+// One entry of the compile-time key map (KeyboardControl::KEY_MAP), 8 bytes
+struct KeyMapEntry {
+    uint32_t mask;        // The key's bit in the scan word
+    uint8_t midi;         // Natural-mode note
+    int8_t whiteKeyPos;   // Compact-mode scale degree (black keys: lower white neighbour)
+    uint8_t bit;          // expanderBit() of mask, for setup and reverse lookup
+    uint8_t reserved;
+
+    constexpr KeyMapEntry(ExpanderBank bank, uint8_t pin, uint8_t midiNote, int8_t whitePos)
+        : mask(1UL << expanderBit(bank, pin)), midi(midiNote), whiteKeyPos(whitePos),
+          bit(expanderBit(bank, pin)), reserved(0) {}
+
+    ExpanderBank bank() const { return (ExpanderBank)(bit >> 4); }
+    uint8_t pin() const { return bit & 0x0F; }
 };
 
 // GPIO cache structure for bulk I2C reads (Performance Optimization)
@@ -60,6 +58,36 @@ struct GPIOCache {
     inline bool isU2PinLow(uint8_t pin) const {
         return !(u2_pins & (1 << pin));
     }
+
+    // Helper: Check if a pin is LOW on the given ExpanderBank
+    inline bool isPinLow(uint8_t bank, uint8_t pin) const {
+        return !((bank == BANK_U1 ? u1_pins : u2_pins) & (1 << pin));
+    }
+
+    // All 32 pins as one word, 1 = LOW: U1 in bits 0-15, U2 in bits 16-31
+    inline uint32_t lowMask() const {
+        return ~(((uint32_t)u2_pins << 16) | u1_pins);
+    }
+};
+
+// Scanner -> music engine event (main.cpp inputEvents ring). A GPIO_SNAPSHOT
+// carries all 32 expander pins (keys, levers, pushes, octave buttons) and is
+// only sent when a pin changed; a TOUCH_SAMPLE carries one raw touchRead().
+// timestamp is when the hardware was read, so the engine can tell how old
+// an event is when it gets to it.
+struct InputEvent {
+    enum Type : uint8_t {
+        GPIO_SNAPSHOT,
+        TOUCH_SAMPLE
+    };
+
+    Type type;
+    uint16_t u1_pins;        // GPIO_SNAPSHOT
+    uint16_t u2_pins;
+    uint32_t touchRaw;       // TOUCH_SAMPLE
+    unsigned long timestamp; // micros()
+
+    GPIOCache gpio() const { return {u1_pins, u2_pins, timestamp}; }
 };
 
 enum class LeverFunctionMode {
@@ -81,6 +109,7 @@ enum class TouchFunctionMode {
     HOLD,
     TOGGLE,
     CONTINUOUS,
+    AFTERTOUCH,  // Channel pressure, rate/dead-band/slew limited (SystemSettings)
 };
 
 enum class InterpolationType {
@@ -89,6 +118,21 @@ enum class InterpolationType {
     LOGARITHMIC
 };
 
+// Lever ramp shape in Q16 (65536 = done) at elapsed of duration ms (elapsed
+// < duration): LINEAR p, EXPONENTIAL p^2, LOGARITHMIC 1-(1-p)^2. Integer
+// only, since it runs every scan while a lever ramps.
+inline int32_t rampProgressQ16(InterpolationType type, unsigned long elapsed, unsigned long duration) {
+    const uint64_t p = ((uint64_t)elapsed << 16) / duration;
+    switch (type) {
+        case InterpolationType::EXPONENTIAL:
+            return (int32_t)((p * p) >> 16);
+        case InterpolationType::LOGARITHMIC:
+            return (int32_t)(65536 - (((65536 - p) * (65536 - p)) >> 16));
+        default:
+            return (int32_t)p;
+    }
+}
+
 enum class ValueMode {
     UNIPOLAR,
     BIPOLAR
@@ -149,6 +193,9 @@ extern Preferences preferences;
 
 extern MIDI_NAMESPACE::MidiInterface<MIDI_NAMESPACE::SerialMIDI<HardwareSerial>> MIDI;
 
+// Queued, non-blocking MIDI output on Serial0 (other tasks use midiOut.post*)
+extern MidiOutput<HardwareSerial> midiOut;
+
 // Lever cooldown after BLE toggle (prevents MIDI output during lever release)
 extern unsigned long leverCooldownUntil;
 
@@ -161,6 +208,22 @@ extern void (*syncLeverPush2Callback)();
 // Callback for notifying BLE when chord settings change from firmware
 extern void (*notifyChordSettingsCallback)();
 
+// Version of the chord shape (ChordSettings chordType, strumPattern,
+// voicing) and of the custom pattern; KeyboardControl rebuilds its voiced
+// intervals only when it moves. Single fields change through setChordShape(),
+// the custom pattern through setCustomPattern(); whole-struct loads (BLE,
+// presets, boot) call chordSettingsChanged() themselves.
+extern std::atomic<uint32_t> chordSettingsVersion;
+inline void chordSettingsChanged() { chordSettingsVersion.fetch_add(1, std::memory_order_release); }
+
+// The writer of one chord-shape field: setChordShape(_chordSettings.voicing, 2)
+template<typename Field, typename Value>
+inline void setChordShape(Field& field, Value value) {
+    if (field == (Field)value) return;
+    field = (Field)value;
+    chordSettingsChanged();
+}
+
 // Callback for notifying BLE when scale settings change from firmware
 extern void (*notifyScaleSettingsCallback)();
 
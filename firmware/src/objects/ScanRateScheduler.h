@@ -0,0 +1,97 @@
+#ifndef SCAN_RATE_SCHEDULER_H
+#define SCAN_RATE_SCHEDULER_H
+
+#include <Arduino.h>
+#include <objects/Constants.h>
+
+// Picks the input scan period from recent activity:
+//   BURST  (INPUT_SCAN_BURST_MS)  for INPUT_BURST_HOLD_MS after a pin edge, so
+//          trills and contact bounce are sampled finely while keys settle
+//   ACTIVE (INPUT_SCAN_ACTIVE_MS) while keys, levers, touch or the arp are in
+//          use, and for INPUT_SETTLE_MS after
+//   IDLE   (INPUT_SCAN_IDLE_MS)   otherwise
+// No period exceeds the latency budget (SystemSettings::scanLatencyBudgetMs),
+// which bounds how late the first edge out of idle can be seen.
+//
+// Owned by readInputs; the serial stats read the counters without locking,
+// which is fine for diagnostics.
+class ScanRateScheduler {
+public:
+    enum Rate : uint8_t {
+        BURST,
+        ACTIVE,
+        IDLE,
+        RATE_COUNT
+    };
+
+    static constexpr unsigned long MIN_BUDGET_MS = INPUT_SCAN_BURST_MS;
+    static constexpr unsigned long MAX_BUDGET_MS = 100;
+
+    void setLatencyBudgetMs(long ms) {
+        if (ms < (long)MIN_BUDGET_MS) ms = ms <= 0 ? INPUT_SCAN_IDLE_MS : MIN_BUDGET_MS;
+        if (ms > (long)MAX_BUDGET_MS) ms = MAX_BUDGET_MS;
+        _budgetMs = (unsigned long)ms;
+    }
+
+    // The scan that just ran saw a pin change
+    void onEdge(unsigned long nowMs) {
+        _lastEdgeMs = nowMs;
+        _edgeSeen = true;
+        onActivity(nowMs);
+    }
+
+    // The engine reports inputs in use
+    void onActivity(unsigned long nowMs) {
+        _lastActivityMs = nowMs;
+        _activitySeen = true;
+    }
+
+    // Choose the wait before the next scan, charging the time since the last
+    // call to the rate chosen then
+    unsigned long nextPeriodMs(unsigned long nowMs) {
+        if (_started) _timeAtMs[_rate] += nowMs - _lastCallMs;
+        _lastCallMs = nowMs;
+        _started = true;
+
+        if (_edgeSeen && nowMs - _lastEdgeMs < INPUT_BURST_HOLD_MS) {
+            _rate = BURST;
+        } else if (_activitySeen && nowMs - _lastActivityMs < INPUT_SETTLE_MS) {
+            _rate = ACTIVE;
+        } else {
+            _rate = IDLE;
+        }
+        return periodMs(_rate);
+    }
+
+    Rate rate() const { return _rate; }
+    unsigned long periodMs(Rate rate) const {
+        static constexpr unsigned long PERIODS[RATE_COUNT] = {INPUT_SCAN_BURST_MS, INPUT_SCAN_ACTIVE_MS,
+                                                              INPUT_SCAN_IDLE_MS};
+        return PERIODS[rate] < _budgetMs ? PERIODS[rate] : _budgetMs;
+    }
+    uint32_t timeAtMs(Rate rate) const { return _timeAtMs[rate]; }
+
+    // "Scan now5ms 1ms:2% 5ms:31% 20ms:67%"
+    void format(char* buf, size_t len) const {
+        uint32_t total = 0;
+        for (const auto t : _timeAtMs) total += t;
+        if (total == 0) total = 1;
+        snprintf(buf, len, "Scan now%lums %lums:%lu%% %lums:%lu%% %lums:%lu%%", periodMs(_rate),
+                 periodMs(BURST), (unsigned long)((uint64_t)_timeAtMs[BURST] * 100 / total),
+                 periodMs(ACTIVE), (unsigned long)((uint64_t)_timeAtMs[ACTIVE] * 100 / total),
+                 periodMs(IDLE), (unsigned long)((uint64_t)_timeAtMs[IDLE] * 100 / total));
+    }
+
+private:
+    Rate _rate = ACTIVE;
+    unsigned long _budgetMs = INPUT_SCAN_IDLE_MS;
+    unsigned long _lastEdgeMs = 0;
+    unsigned long _lastActivityMs = 0;
+    unsigned long _lastCallMs = 0;
+    bool _started = false;
+    bool _edgeSeen = false;
+    bool _activitySeen = false;
+    uint32_t _timeAtMs[RATE_COUNT] = {};
+};
+
+#endif
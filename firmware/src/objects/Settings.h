@@ -1,6 +1,7 @@
 #ifndef SETTINGS_H
 #define SETTINGS_H
 
+#include <stddef.h>
 #include <objects/Globals.h>
 
 // Struct for Lever settings
@@ -67,8 +68,17 @@ struct SystemSettings {
     int deepSleepTimeout;   // in seconds
     int bleTimeout;         // in seconds
     int idleConfirmTimeout; // in seconds
+    int scanLatencyBudgetMs; // Longest input scan period allowed, in ms (1-100)
+    int touchPressureRateHz;     // Touch AFTERTOUCH mode: max messages per second (0 = every sample)
+    int touchPressureDeadBand;   // Touch AFTERTOUCH mode: ignore changes up to this many steps
+    int touchPressureSlew;       // Touch AFTERTOUCH mode: max change per second (0 = unlimited)
 };
 
+// Size of SystemSettings before scanLatencyBudgetMs. Writes and presets of
+// exactly this layout are accepted as a prefix; the fields they lack keep
+// their current values.
+constexpr size_t SYSTEM_SETTINGS_V1_SIZE = offsetof(SystemSettings, scanLatencyBudgetMs);
+
 // ============================================
 // Preset System Structures
 // ============================================
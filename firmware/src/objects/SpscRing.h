@@ -0,0 +1,77 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <Arduino.h>
+#include <atomic>
+
+// Lock-free single-producer / single-consumer ring buffer.
+// One task (or ISR) may push, one other may pop; no mutex is ever taken.
+// N must be a power of two. Indices run free and wrap naturally.
+template<typename T, size_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing size must be a power of two");
+
+public:
+    // --- Producer side ---
+    bool push(const T& value) {
+        const uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= N) return false;
+        _buf[head & (N - 1)] = value;
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // All-or-nothing push of count items (keeps multi-byte messages whole)
+    bool pushAll(const T* values, size_t count) {
+        const uint32_t head = _head.load(std::memory_order_relaxed);
+        if (N - (head - _tail.load(std::memory_order_acquire)) < count) return false;
+        for (size_t i = 0; i < count; i++) {
+            _buf[(head + i) & (N - 1)] = values[i];
+        }
+        _head.store(head + (uint32_t)count, std::memory_order_release);
+        return true;
+    }
+
+    // Free-running index one past the last pushed item
+    uint32_t headIndex() const { return _head.load(std::memory_order_relaxed); }
+
+    // --- Consumer side ---
+    bool pop(T& out) {
+        const uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail == _head.load(std::memory_order_acquire)) return false;
+        out = _buf[tail & (N - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Longest run of items readable without wrapping; sets data to its start
+    size_t peekContiguous(const T*& data) const {
+        const uint32_t tail = _tail.load(std::memory_order_relaxed);
+        const uint32_t avail = _head.load(std::memory_order_acquire) - tail;
+        const uint32_t offset = tail & (N - 1);
+        data = &_buf[offset];
+        const uint32_t toEnd = N - offset;
+        return avail < toEnd ? avail : toEnd;
+    }
+
+    void consume(size_t count) {
+        _tail.store(_tail.load(std::memory_order_relaxed) + (uint32_t)count, std::memory_order_release);
+    }
+
+    // Free-running index of the next item to be popped
+    uint32_t tailIndex() const { return _tail.load(std::memory_order_relaxed); }
+
+    // --- Either side (snapshot) ---
+    size_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+    static constexpr size_t capacity() { return N; }
+
+private:
+    T _buf[N];
+    std::atomic<uint32_t> _head{0};
+    std::atomic<uint32_t> _tail{0};
+};
+
+#endif
@@ -0,0 +1,281 @@
+#ifndef TIMING_WHEEL_H
+#define TIMING_WHEEL_H
+
+#include <Arduino.h>
+
+// Two-level hashed timing wheel for future MIDI events (NoteOff tails, strum
+// and arp steps). 1ms ticks; level 0 covers the next 256ms, level 1 the next
+// ~16s in 256ms blocks that cascade into level 0 as time reaches them.
+// Events live in a fixed node pool (no allocation). schedule() is O(1);
+// advance() touches one slot per elapsed tick, never the whole pool.
+// Events due in the same tick fire in the order they were scheduled.
+//
+// Ticks only bound the bookkeeping, not the timing: advance() also releases
+// events of the coming tick whose exact dueUs has passed, and nextDueUs()
+// reports the exact time of the earliest event, so a caller that wakes at
+// that time fires it with microsecond resolution.
+//
+// Cancellation is by tag: owners stamp events with a generation counter and
+// ignore stale ones when they fire, so there is no removal path.
+//
+// Not thread-safe: callers (musicEngineTask, seqClockTask) serialise on a mutex.
+class TimingWheel {
+public:
+    struct Event {
+        uint8_t kind;  // Owner-defined
+        uint8_t data;  // e.g. MIDI note
+        uint8_t tag;   // Owner-defined generation for cancellation
+    };
+
+    static constexpr unsigned long TICK_US = 1000;
+    static constexpr uint16_t POOL_SIZE = 192;
+    // Nodes held back for urgent events (sequencer steps), so a full pool of
+    // NoteOff tails can never stall the arp or strum
+    static constexpr uint16_t RESERVED_NODES = 4;
+
+    TimingWheel() { reset(); }
+
+    // Drop every pending event and restart the clock at nowUs
+    void reset(unsigned long nowUs = 0) {
+        for (uint16_t i = 0; i < POOL_SIZE; i++) {
+            _nodes[i].next = (i + 1 < POOL_SIZE) ? i + 1 : NIL;
+        }
+        _free = 0;
+        for (auto& s : _level0) s = {NIL, NIL};
+        for (auto& s : _level1) s = {NIL, NIL};
+        _ready = {NIL, NIL};
+        _inUse = 0;
+        _tick = 0;
+        _lastUs = nowUs;
+        _remUs = 0;
+    }
+
+    // Queue ev to fire at dueUs (micros() timebase). Past due times fire on
+    // the next advance(). Returns false (and counts an overflow) if the pool
+    // is exhausted; the caller decides the fail-safe.
+    bool schedule(unsigned long dueUs, const Event& ev, bool urgent = false) {
+        const uint16_t freeNodes = POOL_SIZE - _inUse;
+        if (freeNodes == 0 || (!urgent && freeNodes <= RESERVED_NODES)) {
+            _overflows++;
+            return false;
+        }
+        long aheadUs = (long)(dueUs - _lastUs) + (long)_remUs;
+        if (aheadUs < 0) aheadUs = 0;
+        // Round up so nothing fires before its time
+        uint32_t due = _tick + (uint32_t)((aheadUs + TICK_US - 1) / TICK_US);
+        if (due <= _tick) due = _tick + 1;  // Current tick already processed
+
+        const uint16_t n = _free;
+        _free = _nodes[n].next;
+        _nodes[n].ev = ev;
+        _nodes[n].due = due;
+        _nodes[n].dueUs = dueUs;
+        _inUse++;
+        if (_inUse > _peakInUse) _peakInUse = _inUse;
+        _scheduled++;
+        place(n);
+        return true;
+    }
+
+    // Move the clock to nowUs; events now due become available to pop()
+    void advance(unsigned long nowUs) {
+        unsigned long elapsedUs = (nowUs - _lastUs) + _remUs;
+        _lastUs = nowUs;
+        uint32_t ticks = elapsedUs / TICK_US;
+        _remUs = elapsedUs % TICK_US;
+
+        if (ticks > HORIZON_TICKS) {
+            // Long gap (light sleep): everything pending is overdue
+            for (auto& s : _level1) appendList(_ready, s);
+            for (auto& s : _level0) appendList(_ready, s);
+            _tick += ticks;
+            return;
+        }
+        while (ticks-- > 0) {
+            _tick++;
+            if ((_tick & L0_MASK) == 0) cascade();
+            appendList(_ready, _level0[_tick & L0_MASK]);
+        }
+        // Coming tick's events may still sit in level 1 if it opens a block
+        const uint32_t coming = _tick + 1;
+        releaseEarly(_level0[coming & L0_MASK], nowUs);
+        if ((coming & L0_MASK) == 0) releaseEarly(_level1[(coming >> 8) & L1_MASK], nowUs);
+    }
+
+    // Take the next due event (oldest first); false when none are due.
+    // dueUs is the time it was scheduled for, so periodic events can chain
+    // off it without accumulating scan jitter.
+    bool pop(Event& out, unsigned long& dueUs) {
+        const uint16_t n = _ready.head;
+        if (n == NIL) return false;
+        _ready.head = _nodes[n].next;
+        if (_ready.head == NIL) _ready.tail = NIL;
+        out = _nodes[n].ev;
+        dueUs = _nodes[n].dueUs;
+        _nodes[n].next = _free;
+        _free = n;
+        _inUse--;
+        return true;
+    }
+
+    // Earliest time anything pending becomes due (now if some already are);
+    // false when nothing is pending. Used to arm the sequencer clock timer.
+    bool nextDueUs(unsigned long& out) const {
+        if (_ready.head != NIL) {
+            out = _lastUs;
+            return true;
+        }
+        bool found = false;
+        // First occupied level-0 slot holds the earliest level-0 tick
+        for (uint32_t k = 1; k < L0_SLOTS && !found; k++) {
+            found = earliestIn(_level0[(_tick + k) & L0_MASK], out, found);
+        }
+        // A level-1 block can start before the last level-0 tick, so its
+        // earliest event competes with the level-0 one
+        for (uint32_t b = 1; b < L1_SLOTS; b++) {
+            const List& block = _level1[((_tick >> 8) + b) & L1_MASK];
+            if (block.head != NIL) {
+                found = earliestIn(block, out, found);
+                break;
+            }
+        }
+        return found;
+    }
+
+    // --- Stats ---
+    uint16_t inUse() const { return _inUse; }
+    uint16_t peakInUse() const { return _peakInUse; }
+    uint32_t scheduled() const { return _scheduled; }
+    uint32_t overflows() const { return _overflows; }
+    uint32_t clamped() const { return _clamped; }  // Beyond the ~16s horizon, fired early
+
+    // "Sched n1234 use3/41 ovf0 clamp0"
+    void format(char* buf, size_t len) const {
+        snprintf(buf, len, "Sched n%lu use%u/%u ovf%lu clamp%lu", (unsigned long)_scheduled,
+                 (unsigned)_inUse, (unsigned)_peakInUse, (unsigned long)_overflows, (unsigned long)_clamped);
+    }
+
+private:
+    static constexpr uint16_t NIL = 0xFFFF;
+    static constexpr uint32_t L0_SLOTS = 256;
+    static constexpr uint32_t L0_MASK = L0_SLOTS - 1;
+    static constexpr uint32_t L1_SLOTS = 64;
+    static constexpr uint32_t L1_MASK = L1_SLOTS - 1;
+    static constexpr uint32_t HORIZON_TICKS = L0_SLOTS * L1_SLOTS;
+
+    struct Node {
+        Event ev;
+        uint32_t due;         // Absolute tick
+        unsigned long dueUs;  // As requested (micros() timebase)
+        uint16_t next;
+    };
+
+    struct List {
+        uint16_t head;
+        uint16_t tail;
+    };
+
+    void pushBack(List& list, uint16_t n) {
+        _nodes[n].next = NIL;
+        if (list.tail == NIL) {
+            list.head = n;
+        } else {
+            _nodes[list.tail].next = n;
+        }
+        list.tail = n;
+    }
+
+    // Splice all of src onto the end of dst (O(1)) and empty src
+    void appendList(List& dst, List& src) {
+        if (src.head == NIL) return;
+        if (dst.tail == NIL) {
+            dst.head = src.head;
+        } else {
+            _nodes[dst.tail].next = src.head;
+        }
+        dst.tail = src.tail;
+        src = {NIL, NIL};
+    }
+
+    void place(uint16_t n) {
+        uint32_t due = _nodes[n].due;
+        if (due - _tick < L0_SLOTS) {
+            pushBack(_level0[due & L0_MASK], n);
+            return;
+        }
+        uint32_t blocksAhead = (due >> 8) - (_tick >> 8);
+        if (blocksAhead >= L1_SLOTS) {
+            // Past the horizon: park in the farthest block
+            _clamped++;
+            blocksAhead = L1_SLOTS - 1;
+            due = ((_tick >> 8) + blocksAhead) << 8;
+            _nodes[n].due = due;
+        }
+        pushBack(_level1[(due >> 8) & L1_MASK], n);
+    }
+
+    // Move events of the coming tick whose exact time has passed from slot
+    // to _ready, keeping the rest in scheduling order
+    void releaseEarly(List& slot, unsigned long nowUs) {
+        uint16_t n = slot.head;
+        List keep = {NIL, NIL};
+        while (n != NIL) {
+            const uint16_t next = _nodes[n].next;
+            if ((long)(nowUs - _nodes[n].dueUs) >= 0) {
+                pushBack(_ready, n);
+            } else {
+                pushBack(keep, n);
+            }
+            n = next;
+        }
+        slot = keep;
+    }
+
+    // When node n will actually fire: its dueUs, or its tick boundary if that
+    // is earlier (events clamped at the horizon)
+    unsigned long fireUs(uint16_t n) const {
+        const unsigned long tickUs = _lastUs - _remUs + (_nodes[n].due - _tick) * TICK_US;
+        return (long)(tickUs - _nodes[n].dueUs) < 0 ? tickUs : _nodes[n].dueUs;
+    }
+
+    // Lower out to the earliest fire time in list (if found, out already
+    // holds a candidate); returns whether out is now set
+    bool earliestIn(const List& list, unsigned long& out, bool found) const {
+        for (uint16_t n = list.head; n != NIL; n = _nodes[n].next) {
+            const unsigned long us = fireUs(n);
+            if (!found || (long)(us - out) < 0) {
+                out = us;
+                found = true;
+            }
+        }
+        return found;
+    }
+
+    // Start of a new 256-tick block: spread its level-1 events over level 0
+    void cascade() {
+        List block = _level1[(_tick >> 8) & L1_MASK];
+        _level1[(_tick >> 8) & L1_MASK] = {NIL, NIL};
+        uint16_t n = block.head;
+        while (n != NIL) {
+            const uint16_t next = _nodes[n].next;
+            pushBack(_level0[_nodes[n].due & L0_MASK], n);
+            n = next;
+        }
+    }
+
+    Node _nodes[POOL_SIZE];
+    List _level0[L0_SLOTS];
+    List _level1[L1_SLOTS];
+    List _ready;
+    uint16_t _free;
+    uint16_t _inUse;
+    uint16_t _peakInUse = 0;
+    uint32_t _tick;           // Last tick whose slot has been moved to _ready
+    unsigned long _lastUs;    // micros() at the last advance()
+    unsigned long _remUs;     // Sub-tick remainder carried between advances
+    uint32_t _scheduled = 0;
+    uint32_t _overflows = 0;
+    uint32_t _clamped = 0;
+};
+
+#endif
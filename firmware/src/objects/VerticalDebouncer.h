@@ -0,0 +1,118 @@
+#ifndef VERTICAL_DEBOUNCER_H
+#define VERTICAL_DEBOUNCER_H
+
+#include <Arduino.h>
+
+// Bit-parallel debouncer for all 32 expander pins as one word (see
+// GPIOCache::lowMask(): U1 in bits 0-15, U2 in bits 16-31, 1 = pressed).
+// Each pin has a 5-bit countdown stored "vertically": bit b of every pin's
+// counter lives in _count[b], so one update is a few dozen bitwise ops no
+// matter how many pins are bouncing.
+//
+// A raw edge loads the pin's counter with its window, chosen by the new
+// level (press or release). Elapsed milliseconds are subtracted from all
+// counters at once. A pin whose reading still differs from its stable
+// state when its counter reaches zero flips. That is the per-pin timestamp
+// rule it replaces: the reading must hold for the whole window since its
+// last edge.
+class VerticalDebouncer {
+public:
+    static constexpr uint8_t BITS = 5;
+    static constexpr unsigned long MAX_WINDOW_MS = (1UL << BITS) - 1;
+
+    VerticalDebouncer(uint8_t pressMs, uint8_t releaseMs)
+        : _pressMs(pressMs), _releaseMs(releaseMs) {
+        reset(0, 0);
+    }
+
+    // Take raw as the settled state (boot, wake)
+    void reset(uint32_t raw, unsigned long nowMs) {
+        for (auto& plane : _count) plane = 0;
+        _reading = raw;
+        _stable = raw;
+        _edges = 0;
+        _lastMs = nowMs;
+    }
+
+    // Feed one snapshot; returns the pins whose stable state changed
+    // ("changed & stable"), to be read back from stable()
+    uint32_t update(uint32_t raw, unsigned long nowMs) {
+        _edges = raw ^ _reading;
+        // Snapshot stamps can arrive slightly out of order (a queued one
+        // applied after a rerun stamped later): treat going back as no time
+        // passed, never as a wrapped huge elapsed that clears every window
+        unsigned long elapsed = 0;
+        if ((long)(nowMs - _lastMs) > 0) {
+            elapsed = nowMs - _lastMs;
+            _lastMs = nowMs;
+        }
+        // Common case: same snapshot, nothing settling. Counters of settled
+        // pins are never read again before an edge reloads them.
+        if ((_edges | (_reading ^ _stable)) == 0) return 0;
+        subtract(elapsed < MAX_WINDOW_MS ? elapsed : MAX_WINDOW_MS);
+
+        _reading = raw;
+        if (_edges) {
+            // Restart the window of every pin that moved
+            for (auto& plane : _count) plane &= ~_edges;
+            load(_edges & raw, _pressMs);
+            load(_edges & ~raw, _releaseMs);
+        }
+
+        uint32_t running = 0;
+        for (const auto plane : _count) running |= plane;
+        const uint32_t flip = (raw ^ _stable) & ~running & ~_edges;
+        _stable ^= flip;
+        return flip;
+    }
+
+    uint32_t stable() const { return _stable; }
+    uint32_t edges() const { return _edges; }  // Raw edges seen by the last update()
+
+    // Milliseconds until the earliest pending flip among pins in mask, or -1
+    long waitMs(uint32_t mask = 0xFFFFFFFF) const {
+        uint32_t pending = (_reading ^ _stable) & mask;
+        long wait = -1;
+        while (pending) {
+            const int bit = __builtin_ctz(pending);
+            pending &= pending - 1;
+            long remaining = 0;
+            for (uint8_t b = 0; b < BITS; b++) {
+                remaining |= (long)((_count[b] >> bit) & 1) << b;
+            }
+            if (wait < 0 || remaining < wait) wait = remaining;
+        }
+        return wait;
+    }
+
+private:
+    // Saturating subtract of ms from every counter (borrow ripples across
+    // the planes; lanes that underflow are zeroed)
+    void subtract(unsigned long ms) {
+        if (ms == 0) return;
+        uint32_t borrow = 0;
+        for (uint8_t b = 0; b < BITS; b++) {
+            const uint32_t k = ((ms >> b) & 1) ? 0xFFFFFFFF : 0;
+            const uint32_t a = _count[b];
+            _count[b] = a ^ k ^ borrow;
+            borrow = (~a & (k | borrow)) | (k & borrow);
+        }
+        for (auto& plane : _count) plane &= ~borrow;
+    }
+
+    void load(uint32_t mask, uint8_t value) {
+        for (uint8_t b = 0; b < BITS; b++) {
+            if ((value >> b) & 1) _count[b] |= mask;
+        }
+    }
+
+    uint32_t _count[BITS];
+    uint32_t _reading;  // Last raw snapshot
+    uint32_t _stable;   // Debounced state
+    uint32_t _edges;
+    unsigned long _lastMs;  // Latest time seen
+    uint8_t _pressMs;
+    uint8_t _releaseMs;
+};
+
+#endif